@@ -0,0 +1,226 @@
+//------------------------------------------------------------------------------
+/**
+ * @file adc_sample.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client ADC sampling engine.
+ * @version 0.1
+ * @date 2025-09-15
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+//------------------------------------------------------------------------------
+#include "client.h"
+#include "adc_sample.h"
+
+//------------------------------------------------------------------------------
+//
+// dev cfg 의 ADC 항목을 한번의 sysfs read 로 판정하면 noise 에 의해 fail 및
+// 'R'(re-check) 이 발생함. iio input node 를 open 상태로 유지하고(sysfs_cache) pread 로
+// 여러번 sampling 하여 median/MAD 로 outlier 를 제거한 후 신뢰구간이
+// 판정 범위(max, min) 안/밖에 완전히 들어오는 시점에 판정함.
+//
+// ADC,0,/sys/bus/iio/devices/iio:device0/in_voltage1_input,1400,1300,
+//
+//------------------------------------------------------------------------------
+typedef struct adc_ch__t {
+    int         fd;
+    int         max, min;
+    char        node[STR_PATH_LENGTH];
+    adc_stat_t  stat;
+}   adc_ch_t;
+
+static adc_ch_t ADC_CH[ADC_CH_MAX];
+
+//------------------------------------------------------------------------------
+static void adc_config (char *line, void *arg)
+{
+    char *item;
+    int did;
+    adc_ch_t *pch;
+
+    (void)arg;
+    // ADC, did, node, max, min
+    if (strtok (line, ",") == NULL)             return;
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+    if ((did  = atoi (item)) < 0 || did >= ADC_CH_MAX)  return;
+
+    pch = &ADC_CH[did];
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+    strncpy (pch->node, item, sizeof(pch->node) -1);
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+    pch->max = atoi (item);
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+    pch->min = atoi (item);
+
+    /* fd 는 sysfs_cache 에서 관리함 */
+    pch->fd = sysfs_cache_open (pch->node);
+}
+
+//------------------------------------------------------------------------------
+static int adc_read (adc_ch_t *pch, int *value)
+{
+    char buf[16];
+    int len;
+
+    memset (buf, 0, sizeof(buf));
+    /* sysfs attribute 는 offset 0 에서 read 할 때 마다 새로 변환됨 */
+    if ((len = pread (pch->fd, buf, sizeof(buf) -1, 0)) <= 0)
+        return 0;
+
+    *value = atoi (buf);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+static int int_compare (const void *a, const void *b)
+{
+    return *(const int *)a - *(const int *)b;
+}
+
+//------------------------------------------------------------------------------
+// median/MAD 로 outlier 제거 후 평균 및 신뢰구간(half width)^2 계산
+//------------------------------------------------------------------------------
+static void adc_calc (const int *smp, int cnt, adc_stat_t *ps, double *hw2)
+{
+    int sorted[ADC_SAMPLE_MAX], dev[ADC_SAMPLE_MAX];
+    int i, kept, mad, limit;
+    double sum, var;
+
+    memcpy (sorted, smp, sizeof(int) * cnt);
+    qsort  (sorted, cnt, sizeof(int), int_compare);
+    ps->median = sorted[cnt / 2];
+
+    for (i = 0; i < cnt; i++)
+        dev[i] = abs (sorted[i] - ps->median);
+    qsort (dev, cnt, sizeof(int), int_compare);
+    mad = dev[cnt / 2];
+
+    /* 1.4826 * MAD = 정규분포 sigma 추정값, MAD 가 0 인 경우 1 LSB 로 처리 */
+    limit = (int)(ADC_REJECT_K * 1.4826 * (mad ? mad : 1));
+
+    for (i = 0, kept = 0, sum = 0; i < cnt; i++) {
+        if (abs (sorted[i] - ps->median) > limit)   continue;
+        sum += sorted[i];   kept++;
+    }
+    ps->value    = (int)(sum / kept + 0.5);
+    ps->rejected = cnt - kept;
+
+    for (i = 0, var = 0; i < cnt; i++) {
+        double d = sorted[i] - sum / kept;
+        if (abs (sorted[i] - ps->median) > limit)   continue;
+        var += d * d;
+    }
+    var = (kept > 1) ? var / (kept - 1) : 0;
+
+    /* (z * sd / sqrt(n))^2 */
+    *hw2 = ADC_CONFIDENCE_Z * ADC_CONFIDENCE_Z * var / kept;
+}
+
+//------------------------------------------------------------------------------
+// return 1 : pass, 0 : fail, -1 : 판정 불가 (sample 추가 필요)
+//------------------------------------------------------------------------------
+static int adc_decision (adc_ch_t *pch, double hw2)
+{
+    double lo = pch->stat.value - pch->min, hi = pch->max - pch->stat.value;
+
+    /* 신뢰구간 전체가 범위 안 */
+    if ((lo >= 0) && (hi >= 0) && (lo * lo >= hw2) && (hi * hi >= hw2))
+        return 1;
+    /* 신뢰구간 전체가 범위 밖 */
+    if ((lo < 0) && (lo * lo >= hw2))   return 0;
+    if ((hi < 0) && (hi * hi >= hw2))   return 0;
+
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+int adc_sample_setup (const char *dev_fname)
+{
+    int i, cnt;
+
+    memset (ADC_CH, 0, sizeof(ADC_CH));
+    for (i = 0; i < ADC_CH_MAX; i++)    ADC_CH[i].fd = -1;
+
+    cnt = client_dev_config (dev_fname, "ADC", adc_config, NULL);
+    printf ("%s : %d adc channel configured.\n", __func__, cnt);
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+int adc_sample_stat (int did, adc_stat_t *pstat)
+{
+    if ((did < 0) || (did >= ADC_CH_MAX) || (ADC_CH[did].fd < 0))
+        return 0;
+
+    memcpy (pstat, &ADC_CH[did].stat, sizeof(adc_stat_t));
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// return 1 : pass, 0 : fail, -1 : 설정되지 않은 채널 (lib_dev_check 사용)
+//------------------------------------------------------------------------------
+int adc_sample_check (int did, char *resp)
+{
+    int smp[ADC_SAMPLE_MAX], cnt, status = -1;
+    struct timespec ts, te;
+    double hw2 = 0;
+    adc_ch_t *pch;
+
+    if ((did < 0) || (did >= ADC_CH_MAX) || (ADC_CH[did].fd < 0))
+        return -1;
+
+    pch = &ADC_CH[did];
+    memset (&pch->stat, 0, sizeof(adc_stat_t));
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+
+    for (cnt = 0; cnt < ADC_SAMPLE_MAX; ) {
+        if (!adc_read (pch, &smp[cnt]))
+            break;
+        cnt++;
+        if (cnt < ADC_SAMPLE_MIN)
+            continue;
+
+        adc_calc (smp, cnt, &pch->stat, &hw2);
+        if ((status = adc_decision (pch, hw2)) != -1)
+            break;
+    }
+    clock_gettime (CLOCK_MONOTONIC, &te);
+
+    if (!cnt) {
+        printf ("%s : %s read error!\n", __func__, pch->node);
+        DEVICE_RESP_FORM_INT (resp, 'F', 0);
+        return 0;
+    }
+    if (cnt < ADC_SAMPLE_MIN)
+        adc_calc (smp, cnt, &pch->stat, &hw2);
+
+    /* sample 을 모두 사용한 경우 평균값으로 판정 */
+    if (status == -1)
+        status = (pch->stat.value <= pch->max) && (pch->stat.value >= pch->min);
+
+    pch->stat.status      = status;
+    pch->stat.samples     = cnt;
+    pch->stat.decision_us = (te.tv_sec  - ts.tv_sec)  * 1000000 +
+                            (te.tv_nsec - ts.tv_nsec) / 1000;
+
+    printf ("%s : did = %d, value = %d, median = %d, samples = %d, rejected = %d, time = %d us, %s\n",
+            __func__, did, pch->stat.value, pch->stat.median, pch->stat.samples,
+            pch->stat.rejected, pch->stat.decision_us, status ? "PASS" : "FAIL");
+
+    DEVICE_RESP_FORM_INT (resp, status ? 'P' : 'F', pch->stat.value);
+    return status;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,53 @@
+//------------------------------------------------------------------------------
+/**
+ * @file adc_sample.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client ADC sampling engine.
+ * @version 0.1
+ * @date 2025-09-15
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef	__ADC_SAMPLE_H__
+#define	__ADC_SAMPLE_H__
+
+//------------------------------------------------------------------------------
+#define ADC_CH_MAX          8
+
+/* 한번의 판정에 사용되는 sample 수 (min ~ max) */
+#define ADC_SAMPLE_MIN      8
+#define ADC_SAMPLE_MAX      64
+
+/* median 기준 outlier 제거 범위 (k * 1.4826 * MAD) */
+#define ADC_REJECT_K        3
+
+/* 판정 신뢰구간 (z = 3, 약 99.7%) */
+#define ADC_CONFIDENCE_Z    3
+
+//------------------------------------------------------------------------------
+typedef struct adc_stat__t {
+    int     value;          /* trimmed mean (outlier 제거 후 평균) */
+    int     median;
+    int     samples;        /* 판정까지 사용된 sample 수 */
+    int     rejected;       /* outlier 로 제거된 sample 수 */
+    int     decision_us;    /* 판정까지 걸린 시간 (usec) */
+    int     status;         /* 1 = pass, 0 = fail */
+}   adc_stat_t;
+
+//------------------------------------------------------------------------------
+// function prototype define
+//------------------------------------------------------------------------------
+extern  int adc_sample_setup    (const char *dev_fname);
+extern  int adc_sample_stat     (int did, adc_stat_t *pstat);
+extern  int adc_sample_check    (int did, char *resp);
+
+//------------------------------------------------------------------------------
+#endif	// #define	__ADC_SAMPLE_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+/**
+ * @file cfg_watch.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client config file change detect (inotify).
+ * @version 0.1
+ * @date 2025-10-13
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/inotify.h>
+
+//------------------------------------------------------------------------------
+#include "cfg_watch.h"
+
+//------------------------------------------------------------------------------
+//
+// client_setup 에서 읽은 config 파일의 변경 여부 확인.
+// editor(vim 등) 는 파일을 새로 만들어 rename 하므로 파일이 아닌 폴더를 watch 하고
+// event 의 파일 이름으로 비교함. event 는 cfg_watch_changed() 호출시 non-blocking 으로 읽음.
+//
+//------------------------------------------------------------------------------
+static struct {
+    int     wd;
+    char    name[NAME_MAX + 1];
+}   Watch[CFG_WATCH_MAX];
+
+static int WatchFd = -1, WatchCnt = 0, WatchChanged = 0;
+
+#define CFG_WATCH_MASK  (IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE)
+
+//------------------------------------------------------------------------------
+int cfg_watch_add (const char *fpath)
+{
+    char dir[PATH_MAX];
+    const char *name;
+
+    if (WatchCnt >= CFG_WATCH_MAX)  return 0;
+
+    if ((WatchFd < 0) && ((WatchFd = inotify_init1 (IN_NONBLOCK | IN_CLOEXEC)) < 0)) {
+        printf ("%s : inotify error!\n", __func__);
+        return 0;
+    }
+
+    memset (dir, 0, sizeof(dir));
+    if ((name = strrchr (fpath, '/')) != NULL) {
+        strncpy (dir, fpath, (name - fpath) ? (size_t)(name - fpath) : 1);
+        name++;
+    } else {
+        strcpy (dir, ".");
+        name = fpath;
+    }
+
+    if ((Watch[WatchCnt].wd = inotify_add_watch (WatchFd, dir, CFG_WATCH_MASK)) < 0) {
+        printf ("%s : %s watch error!\n", __func__, dir);
+        return 0;
+    }
+    strncpy (Watch[WatchCnt].name, name, NAME_MAX);
+    WatchCnt++;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// return 1 : 마지막 호출 이후 watch 한 config 파일이 변경됨
+//------------------------------------------------------------------------------
+int cfg_watch_changed (void)
+{
+    char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    int len, i, changed;
+
+    if (WatchFd < 0)    return 0;
+
+    while ((len = read (WatchFd, buf, sizeof(buf))) > 0) {
+        char *ptr = buf;
+
+        while (ptr < buf + len) {
+            struct inotify_event *ev = (struct inotify_event *)ptr;
+
+            ptr += sizeof(struct inotify_event) + ev->len;
+            if (!ev->len)   continue;
+            for (i = 0; i < WatchCnt; i++) {
+                if ((Watch[i].wd == ev->wd) && !strcmp (Watch[i].name, ev->name)) {
+                    printf ("%s : %s changed.\n", __func__, ev->name);
+                    WatchChanged = 1;
+                }
+            }
+        }
+    }
+    changed = WatchChanged;     WatchChanged = 0;
+    return changed;
+}
+
+//------------------------------------------------------------------------------
+void cfg_watch_close (void)
+{
+    if (WatchFd >= 0)   close (WatchFd);
+    WatchFd = -1;   WatchCnt = 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
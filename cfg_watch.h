@@ -0,0 +1,34 @@
+//------------------------------------------------------------------------------
+/**
+ * @file cfg_watch.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client config file change detect (inotify).
+ * @version 0.1
+ * @date 2025-10-13
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef	__CFG_WATCH_H__
+#define	__CFG_WATCH_H__
+
+//------------------------------------------------------------------------------
+/* client.cfg, *_ui.cfg, *_dev.cfg */
+#define CFG_WATCH_MAX       4
+
+//------------------------------------------------------------------------------
+// function prototype define
+//------------------------------------------------------------------------------
+extern  int     cfg_watch_add       (const char *fpath);
+extern  int     cfg_watch_changed   (void);
+extern  void    cfg_watch_close     (void);
+
+//------------------------------------------------------------------------------
+#endif	// #define	__CFG_WATCH_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
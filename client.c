@@ -44,6 +44,44 @@
 volatile int SystemCheckReady = 0, RunningTime = DEFAULT_RUNING_TIME, SelfTestMode = 0;
 volatile int UIStatus = eSTATUS_WAIT;
 
+static const char *BenchNode = NULL;
+
+// soft reset ('B') : option -t 값 유지, reset -> ready('O') 시간
+static int TestTime = DEFAULT_RUNING_TIME, ResetPending = 0;
+static struct timespec ResetTime;
+
+// soft reset : UIStatus, RunningTime 초기화 요청 (RX thread 에서 요청, thread_ui 에서 처리)
+static volatile int UIReset = 0;
+
+// soft reset 요청/완료 횟수. 다른 경우 check thread 의 item 초기화 진행중 (UI RUN 보류)
+static volatile int ResetGen = 0, ResetDoneGen = 0;
+
+// session record & replay
+static const char *RecordFile = NULL, *ReplayFile = NULL;
+static int ReplaySpeed = 1, ReplayReported = 0;
+
+// RX thread 의 item 출력 요청 (RX thread 는 present lock 을 사용하지 않고 thread_ui 에서 출력)
+#define UI_REQ_MAX      64
+
+typedef struct ui_req__t {
+    int     uid, color, has_str;
+    char    str[DEVICE_RESP_SIZE];
+}   ui_req_t;
+
+static struct {
+    ui_req_t    req[UI_REQ_MAX];
+    int         head, tail;
+}   UIReq;
+static pthread_mutex_t UIReqMutex;
+
+// SystemCheckReady 가 아닌 경우의 'R' 재검사 요청 (check thread 에서 처리)
+#define RECHECK_MAX     16
+
+static struct {
+    int     gid[RECHECK_MAX], did[RECHECK_MAX];
+    volatile int    head, tail;
+}   ReCheck;
+
 pthread_t thread_ui;
 pthread_t thread_check;
 
@@ -60,7 +98,10 @@ int print_test_result (client_t *p)
     memset  (resp, 0, sizeof(resp));
     sprintf (resp, "%c,%20s", 'P', get_mac_addr());
     SERIAL_RESP_FORM(serial_resp, 'M', 0, 0, resp);
-    protocol_msg_tx (p->puart, serial_resp);    protocol_msg_tx (p->puart, "\r\n");
+    protocol_msg_tx (&p->tport, serial_resp);    protocol_msg_tx (&p->tport, "\r\n");
+
+    // client.cfg ORDER : 항목별 fail/검사시간 기록
+    test_order_save (p);
 
     // error count
     memset (error_str, 0, sizeof(error_str));
@@ -81,7 +122,7 @@ int print_test_result (client_t *p)
             memset  (resp, 0, sizeof(resp));
             sprintf (resp, "%d,%20s", pos, &error_str[pos][0]);
             SERIAL_RESP_FORM(serial_resp, 'E', 0, 0, resp);
-            protocol_msg_tx (p->puart, serial_resp);    protocol_msg_tx (p->puart, "\r\n");
+            protocol_msg_tx (&p->tport, serial_resp);    protocol_msg_tx (&p->tport, "\r\n");
         }
     }
 
@@ -89,19 +130,76 @@ int print_test_result (client_t *p)
     sprintf (resp, "%c,%20s", error_cnt ? 'F' : 'P',
                                 error_cnt ? "FAIL" : "PASS");
     SERIAL_RESP_FORM(serial_resp, 'X', 0, 0, resp);
-    protocol_msg_tx (p->puart, serial_resp);    protocol_msg_tx (p->puart, "\r\n");
+    protocol_msg_tx (&p->tport, serial_resp);    protocol_msg_tx (&p->tport, "\r\n");
 
     return error_cnt;
 }
 
+//------------------------------------------------------------------------------
+// color = -1 : 색 변경 없음, str = NULL : 문자열 변경 없음
+//------------------------------------------------------------------------------
+static void ui_req_post (int uid, int color, const char *str)
+{
+    ui_req_t *req;
+    int next;
+
+    pthread_mutex_lock (&UIReqMutex);
+    next = (UIReq.head + 1) % UI_REQ_MAX;
+    if (next == UIReq.tail) {
+        pthread_mutex_unlock (&UIReqMutex);
+        printf ("%s : ui request queue full! (uid = %d)\n", __func__, uid);
+        return;
+    }
+    req = &UIReq.req[UIReq.head];
+    req->uid = uid;     req->color = color;     req->has_str = (str != NULL);
+    if (str != NULL) {
+        strncpy (req->str, str, sizeof(req->str) -1);
+        req->str[sizeof(req->str) -1] = 0;
+    }
+    UIReq.head = next;
+    pthread_mutex_unlock (&UIReqMutex);
+}
+
+//------------------------------------------------------------------------------
+// thread_ui 에서 요청된 item 출력 (drop = 1 : soft reset 시 출력하지 않고 버림)
+//------------------------------------------------------------------------------
+static void ui_req_flush (client_t *p, int drop)
+{
+    ui_req_t req;
+
+    while (1) {
+        pthread_mutex_lock (&UIReqMutex);
+        if (UIReq.tail == UIReq.head) {
+            pthread_mutex_unlock (&UIReqMutex);
+            break;
+        }
+        req = UIReq.req[UIReq.tail];
+        UIReq.tail = (UIReq.tail + 1) % UI_REQ_MAX;
+        pthread_mutex_unlock (&UIReqMutex);
+
+        if (drop)   continue;
+
+        present_lock ();
+        if (req.color != -1)
+            ui_set_ritem (p->pfb, p->pui, req.uid, req.color, -1);
+        if (req.has_str)
+            ui_set_sitem (p->pfb, p->pui, req.uid, -1, -1, req.str);
+        present_unlock ();
+    }
+}
+
 //------------------------------------------------------------------------------
 static void *thread_ui_func (void *pclient)
 {
     static int onoff = 0;
     client_t *p = (client_t *)pclient;
 
+    TRACE_THREAD ("thread_ui");
+    // client.cfg RT : rx core 제외
+    rt_profile_worker ();
     while (1) {
         onoff = !onoff;
+        present_lock ();
         ui_set_ritem (p->pfb, p->pui, UID_ALIVE,
             onoff ? COLOR_GREEN : p->pui->bc.uint, -1);
 
@@ -109,12 +207,25 @@ static void *thread_ui_func (void *pclient)
                     -1, -1, onoff ? p->model : __DATE__);
 
         ui_set_sitem (p->pfb, p->pui, UID_IPADDR, -1, -1, get_board_ip());
+        present_unlock ();
+
+        // RX thread 에서 요청된 item 결과 출력
+        ui_req_flush (p, 0);
 
+        // UIStatus 는 thread_ui 에서만 변경 (soft reset 이후 이전 결과를 PRINT 하지 않음)
+        if (UIReset) {
+            RunningTime = TestTime;     UIStatus = eSTATUS_WAIT;
+            UIReset = 0;
+        }
         switch (UIStatus) {
             case eSTATUS_WAIT:
-                if (SystemCheckReady)    UIStatus = eSTATUS_RUN;
+                // item 초기화 전에 'O' 가 수신된 경우 초기화 완료 후 RUN
+                if (SystemCheckReady && (ResetGen == ResetDoneGen))
+                    UIStatus = eSTATUS_RUN;
+                present_lock ();
                 ui_set_sitem (p->pfb, p->pui, UID_STATUS, -1, -1, "WAIT");
                 ui_set_ritem (p->pfb, p->pui, UID_STATUS, p->pui->bc.uint, -1);
+                present_unlock ();
                 break;
             case eSTATUS_RUN:
                 if (RunningTime) {
@@ -122,15 +233,24 @@ static void *thread_ui_func (void *pclient)
 
                     memset  (run_str, 0, sizeof(run_str));
                     sprintf (run_str, "Running(%d)", onoff ? RunningTime : RunningTime--);
+                    present_lock ();
                     ui_set_ritem (p->pfb, p->pui, UID_STATUS, onoff ? RUN_BOX_ON : RUN_BOX_OFF, -1);
                     ui_set_sitem (p->pfb, p->pui, UID_STATUS, -1, -1, run_str);
+                    present_unlock ();
                 } else UIStatus = eSTATUS_PRINT;
 
                 break;
             case eSTATUS_PRINT:
-                ui_set_sitem (p->pfb, p->pui, UID_STATUS, -1, -1, "STOP");
-                ui_set_ritem (p->pfb, p->pui, UID_STATUS,
-                    print_test_result (p) ? COLOR_RED : COLOR_GREEN, -1);
+                if (UIReset || p->stop)
+                    break;
+                {
+                    int err = print_test_result (p);
+
+                    present_lock ();
+                    ui_set_sitem (p->pfb, p->pui, UID_STATUS, -1, -1, "STOP");
+                    ui_set_ritem (p->pfb, p->pui, UID_STATUS, err ? COLOR_RED : COLOR_GREEN, -1);
+                    present_unlock ();
+                }
                 UIStatus = eSTATUS_STOP;
                 break;
             case eSTATUS_STOP:
@@ -140,8 +260,18 @@ static void *thread_ui_func (void *pclient)
                 break;
         }
         if (onoff) {
+            TRACE_BEGIN (t_ui);
             if (p->pui->p_item.timeout) p->pui->p_item.timeout--;
+            present_lock ();
             ui_update (p->pfb, p->pui, -1);
+            present_unlock ();
+            TRACE_END (t_ui, "ui_update");
+        }
+        {
+            // back buffer -> screen (ui cfg 'D' mode)
+            TRACE_BEGIN (t_present);
+            present_update (p->pfb);
+            TRACE_END (t_present, "present_update");
         }
         usleep (UPDATE_UI_DELAY);
     }
@@ -175,6 +305,8 @@ static int find_item_pos (client_t *p, int gid, int did)
     return -1;
 }
 
+//------------------------------------------------------------------------------
+// RX thread 에서 호출되므로 화면 출력은 ui_req_post 로 thread_ui 에 요청함.
 //------------------------------------------------------------------------------
 static int update_ui_data (client_t *p, parse_resp_data_t *pdata)
 {
@@ -185,17 +317,13 @@ static int update_ui_data (client_t *p, parse_resp_data_t *pdata)
     if (uid == -1)  return 0;
 
     if (pdata->status_c != 'C') {
-        if (is_info != INFO_DATA) {
-            ui_set_ritem (p->pfb, p->pui, uid,
-                (pdata->status_i == 1) ? COLOR_GREEN : COLOR_RED, -1);
-        }
+        if (is_info != INFO_DATA)
+            ui_req_post (uid, (pdata->status_i == 1) ? COLOR_GREEN : COLOR_RED, NULL);
     } else {
         /* C command received */
         if (device_resp_check(pdata)) {
-            if (is_info != INFO_DATA) {
-                ui_set_ritem (p->pfb, p->pui, uid,
-                        pdata->status_i ? COLOR_GREEN : COLOR_RED, -1);
-            }
+            if (is_info != INFO_DATA)
+                ui_req_post (uid, pdata->status_i ? COLOR_GREEN : COLOR_RED, NULL);
 
             p->pui->i_item[find_item_pos (p, pdata->gid, pdata->did)].status = pdata->status_i;
             p->pui->i_item[find_item_pos (p, pdata->gid, pdata->did)].complete = 1;
@@ -207,7 +335,7 @@ static int update_ui_data (client_t *p, parse_resp_data_t *pdata)
                 DEVICE_RESP_FORM_STR(resp, (pdata->status_i == 1) ? 'P': 'F', pdata->resp_s);
                 SERIAL_RESP_FORM(serial_resp, 'S', pdata->gid, pdata->did, resp);
 
-                protocol_msg_tx (p->puart, serial_resp);    protocol_msg_tx (p->puart, "\r\n");
+                protocol_msg_tx (&p->tport, serial_resp);    protocol_msg_tx (&p->tport, "\r\n");
             }
         }
         else
@@ -237,10 +365,81 @@ static int update_ui_data (client_t *p, parse_resp_data_t *pdata)
         default :
             break;
     }
-    ui_set_sitem (p->pfb, p->pui, uid, -1, -1, pstr);
+    ui_req_post (uid, -1, pstr);
     return 1;
 }
 
+//------------------------------------------------------------------------------
+// session replay (-r) : 기록된 'S' 응답 중 gid/did 가 같은 frame 을 검사 결과로 사용.
+//------------------------------------------------------------------------------
+static int replay_match (const char *frame, void *arg)
+{
+    parse_resp_data_t pdata, *pitem = (parse_resp_data_t *)arg;
+
+    if (!device_resp_parse (frame, &pdata))  return 0;
+    return (pdata.cmd == 'S') && (pdata.gid == pitem->gid) && (pdata.did == pitem->did);
+}
+
+//------------------------------------------------------------------------------
+// consume = 0 인 경우 기록 여부만 확인. return 1 : 기록 있음
+//------------------------------------------------------------------------------
+static int replay_device_resp (int gid, int did, parse_resp_data_t *pdata, int consume)
+{
+    char frame[SERIAL_RESP_SIZE * 2 +1];
+    parse_resp_data_t pitem;
+
+    pitem.gid = gid;    pitem.did = did;
+    if (!session_replay_tx (replay_match, &pitem, frame, consume))
+        return 0;
+    return device_resp_parse (frame, pdata);
+}
+
+//------------------------------------------------------------------------------
+static int replay_device_check (int gid, int did, char *dev_resp)
+{
+    parse_resp_data_t pdata;
+
+    if (!replay_device_resp (gid, did, &pdata, 1)) {
+        DEVICE_RESP_FORM_STR (dev_resp, 'F', "no record");
+        return 0;
+    }
+    DEVICE_RESP_FORM_STR (dev_resp, pdata.status_c, pdata.resp_s);
+    return (pdata.status_c != 'F');
+}
+
+//------------------------------------------------------------------------------
+// client 측 check engine 에서 처리하는 항목은 engine 을 사용하고
+// 그외 항목은 lib_dev_check 의 device_check 를 사용함.
+// session replay 중에는 hardware 를 사용하지 않고 기록된 결과를 사용함.
+//------------------------------------------------------------------------------
+static int client_device_check (int gid, int did, char *dev_resp)
+{
+    int status;
+
+    if (session_replay_active ())
+        return replay_device_check (gid, did, dev_resp);
+
+    switch (gid) {
+        case eGID_SYSTEM:
+            if (did == eSYSTEM_MEM_TEST) {
+                if ((status = mem_test_check (dev_resp)) != -1)
+                    return status;
+            }
+            break;
+        case eGID_ADC:
+            if ((status = adc_sample_check (did, dev_resp)) != -1)
+                return status;
+            break;
+        case eGID_IR:
+            if ((status = ir_event_check (dev_resp)) != -1)
+                return status;
+            break;
+        default :
+            break;
+    }
+    return device_check (gid, did, dev_resp);
+}
+
 //------------------------------------------------------------------------------
 void client_data_check (client_t *p, int check_item, void *dev_resp)
 {
@@ -262,8 +461,8 @@ void client_data_check (client_t *p, int check_item, void *dev_resp)
         char serial_resp[SERIAL_RESP_SIZE +1], *resp;
         SERIAL_RESP_FORM(serial_resp, 'S', gid, did, (char *)dev_resp);
 
-        protocol_msg_tx (p->puart, serial_resp);
-        protocol_msg_tx (p->puart, "\r\n");
+        protocol_msg_tx (&p->tport, serial_resp);
+        protocol_msg_tx (&p->tport, "\r\n");
 
         // cmd check 'C'
         resp = (char *)dev_resp;
@@ -284,46 +483,69 @@ void client_data_check (client_t *p, int check_item, void *dev_resp)
                     break;
             }
 
+            TRACE_BEGIN (t_ack);
             do {
                 usleep (FUNC_LOOP_DELAY);
                 if (p->req_wait_delay)  p->req_wait_delay--;
-            }   while (p->req_wait_delay && !p->req_ack);
+            }   while (p->req_wait_delay && !p->req_ack && !p->stop);
+            TRACE_END (t_ack, "ack_wait");
         }
     }
 }
 
 //------------------------------------------------------------------------------
-static void *thread_check_func (void *pclient)
+// soft reset (p->stop) 시 결과를 server 로 보내지 않고 바로 return
+//------------------------------------------------------------------------------
+static void client_check_run (client_t *p)
 {
-    int check_item = 0, pass_item = 0, gid, did, uid;
+    int check_item = 0, pass_item = 0, pos, gid, did, uid, status, ir_wait;
     char dev_resp[DEVICE_RESP_SIZE];
-    client_t *p = (client_t *)pclient;
+    struct timespec ts, te;
 
-    while (!SystemCheckReady)    usleep (FUNC_LOOP_DELAY);
+    // client.cfg ORDER : 검사 순서 (기본 ui cfg 순서)
+    test_order_build (p);
 
-    while (pass_item != p->pui->i_item_cnt) {
-        for (check_item = 0, pass_item = 0; check_item < p->pui->i_item_cnt; check_item++) {
+    while ((pass_item != p->pui->i_item_cnt) && !p->stop) {
+        for (pos = 0, pass_item = 0, ir_wait = 0; pos < p->pui->i_item_cnt; pos++) {
+            check_item = test_order_item (pos);
             uid = p->pui->i_item[check_item].ui_id;
             gid = p->pui->i_item[check_item].grp_id;
             did = p->pui->i_item[check_item].dev_id;
 
             switch (gid) {
                 case eGID_LED:
+                    // LED batch check (option -s, session replay 제외)
+                    if (!SelfTestMode && !session_replay_active () &&
+                        !p->pui->i_item[check_item].complete) {
+                        if (led_check_batch (p))
+                            continue;
+                    }
                     if ((DEVICE_ID(did) == eLED_100M) || (DEVICE_ID(did) == eLED_1G)) {
                         // if iperf_value == 0 then skip eth led test
-                        if (!get_ethernet_iperf())  {
+                        // (session replay 시 기록된 결과가 없으면 skip)
+                        parse_resp_data_t pdata;
+                        if (session_replay_active () ?
+                            !replay_device_resp (gid, did, &pdata, 0) : !get_ethernet_iperf()) {
                             printf ("%s : skip %d : %d, complete = %d\n",
                                 __func__, gid, did, p->pui->i_item[check_item].complete);
                             continue;
                         }
                     }
                     break;
+                case eGID_IR:
+                    // ir_event 에서 pass count 에 도달할 때 까지 대기 (loop delay 에서 event 대기)
+                    if (!session_replay_active () && (ir_event_ready () == 0)) {
+                        ir_wait = 1;
+                        continue;
+                    }
+                    break;
                 default :
                     break;
             }
             memset (dev_resp, 0, sizeof(dev_resp));
 
             if (!p->pui->i_item[check_item].complete) {
+                present_lock ();
                 if (p->pui->i_item[check_item].is_info != INFO_DATA)
                     ui_set_ritem (p->pfb, p->pui, uid, COLOR_YELLOW, -1);
 
@@ -333,8 +555,20 @@ static void *thread_check_func (void *pclient)
                         COLOR_RED, COLOR_BLACK, COLOR_RED,
                         2, 10, "%s", "USB F/W Check & Upgrade");
                 }
-                p->pui->i_item[check_item].status =
-                    device_check (gid, did, dev_resp);
+                present_unlock ();
+                clock_gettime (CLOCK_MONOTONIC, &ts);
+                {
+                    TRACE_BEGIN (t_check);
+                    status = client_device_check (gid, did, dev_resp);
+                    TRACE_END (t_check, "device_check");
+                }
+                // soft reset 전에 시작된 check 결과는 버림
+                if (p->stop)
+                    return;
+                // mem test 실행중 'R' 로 중단된 경우 결과를 보내지 않고 다음 loop 에서 재실행
+                if (status == MEM_TEST_RETRY)
+                    continue;
+                p->pui->i_item[check_item].status = status;
 
                 if (gid == eGID_FW) {
                     if (p->pui->i_item[check_item].status) {
@@ -355,23 +589,180 @@ static void *thread_check_func (void *pclient)
                 }
                 client_data_check (p, check_item, dev_resp);
 
+                // client.cfg ORDER : 검사시간 (ack 대기 포함)
+                clock_gettime (CLOCK_MONOTONIC, &te);
+                test_order_time (check_item, (te.tv_sec - ts.tv_sec) * 1000 +
+                                             (te.tv_nsec - ts.tv_nsec) / 1000000);
             }   else pass_item++;
 
+            // soft reset
+            if (p->stop)
+                return;
+
+            // client.cfg ORDER : hard fail 시 남은 항목을 검사하지 않고 바로 종료
+            // (결과 출력은 'X' command 와 같이 thread_ui 에서 RunningTime 만료 후 처리)
+            if (test_order_abort (p)) {
+                if (RunningTime > 1)    RunningTime = 1;
+                SystemCheckReady = 0;
+                return;
+            }
+
             // force stop
             if (!RunningTime) {
                 // check complete
                 RunningTime = 0;    SystemCheckReady = 0;
-                return pclient;
+                return;
             }
         }
-        // loop delay
-        usleep (FUNC_LOOP_DELAY);
+        // loop delay (IR 대기중인 경우 pass count 도달 즉시 진행)
+        if (ir_wait)    ir_event_wait (FUNC_LOOP_DELAY / 1000);
+        else            usleep (FUNC_LOOP_DELAY);
     }
     // check complete
-    RunningTime = 0;    SystemCheckReady = 0;
+    if (!p->stop) {
+        RunningTime = 0;    SystemCheckReady = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+// soft reset : item 상태, 문자열, LED 초기화 (check thread 에서 실행)
+//------------------------------------------------------------------------------
+static void client_item_reset (client_t *p)
+{
+    char *str;
+    int i;
+
+    p->req_ack = 0;         p->req_wait_delay = 0;
+    p->pui->p_item.timeout = 0;
+
+    // reset 전에 요청된 재검사, item 출력은 버림
+    ReCheck.tail = ReCheck.head;
+    ui_req_flush (p, 1);
+
+    present_lock ();
+    for (i = 0; i < p->pui->i_item_cnt; i++) {
+        i_item_t *i_item = &p->pui->i_item[i];
+
+        i_item->complete = 0;   i_item->status = 0;
+        if (i_item->is_info != INFO_DATA)
+            ui_set_ritem (p->pfb, p->pui, i_item->ui_id, p->pui->bc.uint, -1);
+        if ((i_item->is_info != INFO_STATUS) && ((str = client_ui_str (i_item->ui_id)) != NULL))
+            ui_set_sitem (p->pfb, p->pui, i_item->ui_id, -1, -1, str);
+    }
+    present_unlock ();
+    led_check_reset ();
+
+    // UIStatus, RunningTime 은 thread_ui 에서 초기화 후 check 시작 (UIReset 은 RX thread 에서 요청)
+    while (UIReset && !p->stop)     usleep (FUNC_LOOP_DELAY);
+}
+
+//------------------------------------------------------------------------------
+// check 대기중 수신된 'R' 재검사 (RX thread 에서 device check 를 하지 않음)
+//------------------------------------------------------------------------------
+static void client_recheck_run (client_t *p)
+{
+    char serial_resp[SERIAL_RESP_SIZE +1], dev_resp[DEVICE_RESP_SIZE +1];
+    int gid, did, check_item, status;
+
+    while ((ReCheck.tail != ReCheck.head) && !p->stop) {
+        gid = ReCheck.gid[ReCheck.tail];
+        did = ReCheck.did[ReCheck.tail];
+        ReCheck.tail = (ReCheck.tail + 1) % RECHECK_MAX;
+
+        if ((check_item = find_item_pos (p, gid, did)) == -1)
+            continue;
+
+        do {
+            memset (dev_resp, 0, sizeof(dev_resp));
+            status = client_device_check (gid, did, dev_resp);
+        }   while ((status == MEM_TEST_RETRY) && !p->stop);
+
+        // soft reset 전에 시작된 check 결과는 버림
+        if (p->stop)    return;
+        p->pui->i_item[check_item].status = status;
+
+        memset (serial_resp, 0, sizeof(serial_resp));
+        SERIAL_RESP_FORM(serial_resp, 'S', gid, did, dev_resp);
+        protocol_msg_tx (&p->tport, serial_resp);
+        protocol_msg_tx (&p->tport, "\r\n");
+    }
+}
+
+//------------------------------------------------------------------------------
+static void *thread_check_func (void *pclient)
+{
+    client_t *p = (client_t *)pclient;
+
+    TRACE_THREAD ("thread_check");
+    // client.cfg RT : rx core 제외
+    rt_profile_worker ();
+    while (1) {
+        // soft reset 요청 처리중 다시 요청된 경우 한번 더 초기화
+        while (p->stop) {
+            int gen;
+
+            p->stop = 0;
+            __sync_synchronize ();
+            gen = ResetGen;
+            client_item_reset (p);
+            ResetDoneGen = gen;
+        }
+        while (!SystemCheckReady && !p->stop) {
+            client_recheck_run (p);
+            usleep (FUNC_LOOP_DELAY);
+        }
+        if (p->stop)    continue;
+
+        client_check_run (p);
+
+        // check 완료 후 다음 soft reset 대기
+        while (!p->stop) {
+            client_recheck_run (p);
+            usleep (FUNC_LOOP_DELAY);
+        }
+    }
     return pclient;
 }
 
+//------------------------------------------------------------------------------
+// server 'B' : app 재시작 없이 check thread 와 item 상태만 초기화.
+// UART, fb, UI, config, check engine 은 유지하고 boot msg('R') 재전송.
+// RX thread 는 check thread 를 기다리지 않음. (ack 대기, LED batch, mem test 는
+// p->stop, mem_test_reset 으로 중단되고 item 상태는 check thread 에서 초기화)
+// UIStatus, RunningTime 은 여기서 바로 thread_ui 에 초기화 요청하고, item 초기화가
+// 끝날 때 까지(ResetDoneGen) 'O' 가 먼저 수신되어도 RUN 으로 진행하지 않음.
+//------------------------------------------------------------------------------
+static void client_soft_reset (client_t *p)
+{
+    char serial_resp[SERIAL_RESP_SIZE +1];
+
+    clock_gettime (CLOCK_MONOTONIC, &ResetTime);
+
+    SystemCheckReady = 0;
+    UIReset = 1;
+    ResetGen++;
+    __sync_synchronize ();
+    p->stop = 1;
+    ir_event_reset ();
+    mem_test_reset ();
+
+    // Send boot msg & Wait for Ready msg
+    SERIAL_RESP_FORM(serial_resp, 'R', -1, -1, NULL);
+    protocol_msg_tx (&p->tport, serial_resp);    protocol_msg_tx (&p->tport, "\r\n");
+
+    // option -s
+    if (SelfTestMode)   SystemCheckReady = 1;
+
+    {
+        struct timespec te;
+
+        clock_gettime (CLOCK_MONOTONIC, &te);
+        printf ("%s : soft reset, boot msg sent %ld us\n", __func__,
+                (te.tv_sec - ResetTime.tv_sec) * 1000000 + (te.tv_nsec - ResetTime.tv_nsec) / 1000);
+    }
+    ResetPending = 1;
+}
+
 //------------------------------------------------------------------------------
 static void protocol_parse (client_t *p)
 {
@@ -383,6 +774,15 @@ static void protocol_parse (client_t *p)
     switch (pitem.cmd) {
         case 'O':
             SystemCheckReady = 1;
+            // soft reset -> server ready 시간
+            if (ResetPending) {
+                struct timespec te;
+
+                clock_gettime (CLOCK_MONOTONIC, &te);
+                printf ("%s : reset to ready %ld ms\n", __func__,
+                        (te.tv_sec - ResetTime.tv_sec) * 1000 + (te.tv_nsec - ResetTime.tv_nsec) / 1000000);
+                ResetPending = 0;
+            }
             break;
         case 'X':
             // force stop
@@ -392,32 +792,49 @@ static void protocol_parse (client_t *p)
         case 'E':
             if (!RunningTime)
                 print_test_result (p);
+            // -D__TRACE__ : test cycle trace 저장
+            TRACE_DUMP ();
+            rt_latency_report ();
             break;
         case 'B':
-            printf ("%s : server reboot!! client reboot!\n", __func__);
-            fflush (stdout);
-            exit (0);   // normal exit than app restart.
+            // config 파일이 변경된 경우 app 재시작 (client_setup 에서 전체 초기화)
+            if (cfg_watch_changed ()) {
+                printf ("%s : server reboot!! config changed, client reboot!\n", __func__);
+                fflush (stdout);
+                exit (0);   // normal exit than app restart.
+            }
+            printf ("%s : server reboot!! client soft reset!\n", __func__);
+            client_soft_reset (p);
+            break;
         case 'R':
             // item check status init (re-check)
             {
                 int check_item = find_item_pos (p, pitem.gid, pitem.did);
 
+                if (check_item == -1)   break;
+                if ((pitem.gid == eGID_SYSTEM) && (pitem.did == eSYSTEM_MEM_TEST))
+                    mem_test_reset ();
+
                 if (SystemCheckReady) {
+                    // IR count 는 재검사(check thread)에서 새로 받은 event 만 사용
+                    if (pitem.gid == eGID_IR)
+                        ir_event_reset ();
                     p->pui->i_item[check_item].complete = 0;
                     p->pui->i_item[check_item].status = 0;
                     RunningTime += 5;
                 } else {
-                    char serial_resp[SERIAL_RESP_SIZE +1], dev_resp[DEVICE_RESP_SIZE +1];
-
-                    memset (serial_resp, 0, sizeof(serial_resp));
-                    memset (dev_resp, 0, sizeof(dev_resp));
-
-                    p->pui->i_item[check_item].status =
-                                device_check (pitem.gid, pitem.did, dev_resp);
+                    // device check 는 check thread 에서 실행 후 결과('S') 전송
+                    int next = (ReCheck.head + 1) % RECHECK_MAX;
 
-                    SERIAL_RESP_FORM(serial_resp, 'S', pitem.gid, pitem.did, dev_resp);
-                    protocol_msg_tx (p->puart, serial_resp);
-                    protocol_msg_tx (p->puart, "\r\n");
+                    if (next == ReCheck.tail) {
+                        printf ("%s : re-check queue full! gid = %d, did = %d\n",
+                                __func__, pitem.gid, pitem.did);
+                        break;
+                    }
+                    ReCheck.gid[ReCheck.head] = pitem.gid;
+                    ReCheck.did[ReCheck.head] = pitem.did;
+                    __sync_synchronize ();
+                    ReCheck.head = next;
                 }
             }
             break;
@@ -449,6 +866,10 @@ static void print_usage (const char *prog)
     puts("\n"
         " -s             : self test mode. default = 0\n"
         " -t {test time} : board test time\n"
+        " -b {node}      : sysfs/procfs node read benchmark\n"
+        " -c {file}      : record protocol session (rx/tx frame)\n"
+        " -r {file}      : replay recorded protocol session\n"
+        " -x {speed}     : replay speed (1 = real time, N = xN, 0 = max). default = 1\n"
         " -h             : usage screen\n"
         "\n"
     );
@@ -462,12 +883,16 @@ static void parse_opts (int argc, char *argv[])
         static const struct option lopts[] = {
             { "self test mode"  ,  0, 0, 's' },
             { "board test time" ,  1, 0, 't' },
+            { "read benchmark"  ,  1, 0, 'b' },
+            { "session record"  ,  1, 0, 'c' },
+            { "session replay"  ,  1, 0, 'r' },
+            { "replay speed"    ,  1, 0, 'x' },
             { "board test time" ,  0, 0, 'h' },
             { NULL, 0, 0, 0 },
         };
         int c;
 
-        c = getopt_long(argc, argv, "st:h", lopts, NULL);
+        c = getopt_long(argc, argv, "st:b:c:r:x:h", lopts, NULL);
 
         if (c == -1)
             break;
@@ -481,6 +906,18 @@ static void parse_opts (int argc, char *argv[])
             if (RunningTime < 0)
                 RunningTime = DEFAULT_RUNING_TIME;
             break;
+        case 'b':
+            BenchNode = optarg;
+            break;
+        case 'c':
+            RecordFile = optarg;
+            break;
+        case 'r':
+            ReplayFile = optarg;
+            break;
+        case 'x':
+            ReplaySpeed = atoi (optarg);
+            break;
         case 'h':
         default:
             print_usage(argv[0]);
@@ -500,6 +937,33 @@ int main (int argc, char *argv[])
     // option check
     parse_opts(argc, argv);
 
+    // option -t (soft reset 시 사용)
+    TestTime = RunningTime;
+
+    // -D__TRACE__
+    TRACE_SETUP ();
+    TRACE_THREAD ("main");
+
+    // option -b
+    if (BenchNode) {
+        sysfs_cache_bench (BenchNode, SYSFS_BENCH_LOOPS);
+        return 0;
+    }
+
+    // option -c, -r
+    if (RecordFile && !session_record_open (RecordFile))    exit(1);
+    if (ReplayFile && !session_replay_open (ReplayFile, ReplaySpeed))   exit(1);
+
+    // RX thread 가 ui 요청 중 대기하는 경우 우선순위 상속
+    {
+        pthread_mutexattr_t attr;
+
+        pthread_mutexattr_init (&attr);
+        pthread_mutexattr_setprotocol (&attr, PTHREAD_PRIO_INHERIT);
+        pthread_mutex_init (&UIReqMutex, &attr);
+        pthread_mutexattr_destroy (&attr);
+    }
+
     // UI, UART
     client_setup (&client);
 
@@ -509,22 +973,50 @@ int main (int argc, char *argv[])
     // popup disable
     client.pui->p_item.timeout = 0;
 
+    // client.cfg RT : main(RX) thread SCHED_FIFO, mlockall (worker thread 생성 후)
+    rt_profile_rx ();
+
     // Send boot msg & Wait for Ready msg
     {
         char serial_resp[SERIAL_RESP_SIZE +1];
 
         SystemCheckReady = 0;
         SERIAL_RESP_FORM(serial_resp, 'R', -1, -1, NULL);
-        protocol_msg_tx (client.puart, serial_resp);    protocol_msg_tx (client.puart, "\r\n");
+        protocol_msg_tx (&client.tport, serial_resp);    protocol_msg_tx (&client.tport, "\r\n");
     }
 
     // option -s
     if (SelfTestMode)   SystemCheckReady = 1;
 
     while (1) {
-        if (protocol_msg_rx (client.puart, client.rx_msg))
+        int rx = protocol_msg_rx (&client.tport, client.rx_msg);
+
+        if (rx && session_replay_active ()) {
+            struct timespec ts, te;
+
+            clock_gettime (CLOCK_MONOTONIC, &ts);
             protocol_parse  (&client);
-        usleep (MAIN_LOOP_DELAY);
+            clock_gettime (CLOCK_MONOTONIC, &te);
+            session_replay_parse ((te.tv_sec - ts.tv_sec) * 1000000000L + (te.tv_nsec - ts.tv_nsec));
+        }
+        else if (rx) {
+            TRACE_BEGIN (t_parse);
+            protocol_parse  (&client);
+            TRACE_END (t_parse, "protocol_parse");
+            rt_latency_dispatch ();
+        }
+        // -D__TRACE__ : kill -USR1 요청 처리
+        TRACE_POLL ();
+
+        // option -r : replay 완료시 결과 출력 (1회)
+        if (session_replay_done () && !ReplayReported) {
+            session_replay_report ();
+            ReplayReported = 1;
+        }
+        // replay 중 frame 이 있는 경우 loop delay 없음 (-x 0 : max speed)
+        // client.cfg RT : frame 이 있는 경우 loop delay 없음 (수신된 frame 연속 처리)
+        if (!rx || !(session_replay_active () || rt_profile_active ()))
+            rt_latency_sleep (MAIN_LOOP_DELAY);
     }
     return 0;
 }
@@ -23,6 +23,17 @@
 #include "lib_uart/lib_uart.h"
 #include "lib_dev_check/lib_dev_check.h"
 #include "protocol.h"
+#include "sysfs_cache.h"
+#include "adc_sample.h"
+#include "led_check.h"
+#include "ir_event.h"
+#include "mem_test.h"
+#include "session.h"
+#include "present.h"
+#include "trace.h"
+#include "rt_profile.h"
+#include "test_order.h"
+#include "cfg_watch.h"
 
 //------------------------------------------------------------------------------
 #define CLIENT_HW_CONFIG        "client.cfg"
@@ -56,6 +67,9 @@
 #define CHECK_CMD_DELAY     (500*1000)
 #define UPDATE_UI_DELAY     (500*1000)
 
+/* ui cfg 'B' 초기 문자열 저장 (ui id 범위) */
+#define UI_STR_MAX          256
+
 //------------------------------------------------------------------------------
 // system state
 //------------------------------------------------------------------------------
@@ -76,6 +90,9 @@ typedef struct client__t {
 
     // UART communication
     uart_t      *puart;
+
+    // protocol transport (UART, TCP, Unix socket)
+    transport_t tport;
     char        rx_msg [SERIAL_RESP_SIZE +1];
     char        tx_msg [SERIAL_RESP_SIZE +1];
 
@@ -84,6 +101,9 @@ typedef struct client__t {
     int         req_did;    /* request device id */
     int         req_ack;    /* 0 = ack not yet, 1 = ack ok */
     int         req_wait_delay; /* limite wait delay */
+
+    // check thread stop request (soft reset)
+    volatile int    stop;
 }   client_t;
 
 //------------------------------------------------------------------------------
@@ -92,7 +112,10 @@ typedef struct client__t {
 //------------------------------------------------------------------------------
 // setup.c
 //------------------------------------------------------------------------------
+extern  int client_dev_config (const char *dev_fname, const char *grp,
+                                void (*func)(char *line, void *arg), void *arg);
 extern  int client_setup (client_t *p);
+extern  char *client_ui_str (int uid);
 
 //------------------------------------------------------------------------------
 #endif	// #define	__CLIENT_H__
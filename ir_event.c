@@ -0,0 +1,277 @@
+//------------------------------------------------------------------------------
+/**
+ * @file ir_event.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client IR receiver check (evdev, epoll).
+ * @version 0.1
+ * @date 2025-09-22
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <linux/input.h>
+
+//------------------------------------------------------------------------------
+#include "client.h"
+#include "ir_event.h"
+
+//------------------------------------------------------------------------------
+//
+// IR,-1,meson-ir,3,0,  (event find str, pass_count, pass_key_code)
+//
+// 설정된 이름의 input device 를 한번 open 하여 epoll 에 등록하고
+// key press 이벤트가 들어올 때 마다 count 함. (timed polling 없음)
+// pass_count 에 도달하는 즉시 완료되며 ir_event_wait 로 대기중인 check thread 를 깨움.
+// 이벤트 간 간격(latency) 평균은 결과 문자열로 server 에 전달함.
+// event find str 이 '/' 로 시작하는 경우 input event node 경로로 사용함.
+// (uinput 가상 device 또는 fifo 로 장비 없이 확인 가능)
+//
+//------------------------------------------------------------------------------
+typedef struct ir_dev__t {
+    int     fd, efd;
+    int     pass_count, key_code;
+    char    name[STR_NAME_LENGTH];
+    char    node[STR_PATH_LENGTH];
+
+    volatile int    count;
+    struct timespec t_start, t_last;
+    long    lat_min, lat_max, lat_sum;  /* 이벤트 간 간격 (usec) */
+    long    done_us;                    /* reset 부터 완료까지 시간 (usec) */
+}   ir_dev_t;
+
+static ir_dev_t IR = { .fd = -1, .efd = -1, };
+
+static pthread_t thread_ir;
+static pthread_mutex_t IRMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  IRCond  = PTHREAD_COND_INITIALIZER;
+
+//------------------------------------------------------------------------------
+static long diff_us (struct timespec *ts, struct timespec *te)
+{
+    return (te->tv_sec - ts->tv_sec) * 1000000 + (te->tv_nsec - ts->tv_nsec) / 1000;
+}
+
+//------------------------------------------------------------------------------
+static void ir_config (char *line, void *arg)
+{
+    char *item;
+
+    (void)arg;
+    // IR, -1, event find str, pass_count, pass_key_code
+    if (strtok (line, ",") == NULL)             return;
+    if (strtok (NULL, ",") == NULL)             return;
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+    strncpy (IR.name, item, sizeof(IR.name) -1);
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+    IR.pass_count = atoi (item);
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+    IR.key_code   = atoi (item);
+}
+
+//------------------------------------------------------------------------------
+static int ir_find_device (const char *name, char *node)
+{
+    char path[STR_PATH_LENGTH], buf[STR_NAME_LENGTH];
+    FILE *fp;
+    int i;
+
+    for (i = 0; i < IR_INPUT_MAX; i++) {
+        sprintf (path, "%s/event%d/device/name", IR_INPUT_CLASS, i);
+        if ((fp = fopen (path, "r")) == NULL)
+            continue;
+
+        memset (buf, 0, sizeof(buf));
+        if ((fgets (buf, sizeof(buf), fp) != NULL) && (strstr (buf, name) != NULL)) {
+            sprintf (node, "/dev/input/event%d", i);
+            fclose (fp);
+            return 1;
+        }
+        fclose (fp);
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+static void ir_event_count (void)
+{
+    struct timespec now;
+    long lat;
+
+    pthread_mutex_lock (&IRMutex);
+    if (IR.count < IR.pass_count) {
+        clock_gettime (CLOCK_MONOTONIC, &now);
+        if (IR.count) {
+            lat = diff_us (&IR.t_last, &now);
+            if (!IR.lat_min || (lat < IR.lat_min))  IR.lat_min = lat;
+            if (lat > IR.lat_max)                   IR.lat_max = lat;
+            IR.lat_sum += lat;
+        }
+        IR.t_last = now;
+        if (++IR.count == IR.pass_count) {
+            IR.done_us = diff_us (&IR.t_start, &now);
+            printf ("%s : %s %d event received, %ld ms\n",
+                    __func__, IR.name, IR.count, IR.done_us / 1000);
+            pthread_cond_broadcast (&IRCond);
+        }
+    }
+    pthread_mutex_unlock (&IRMutex);
+}
+
+//------------------------------------------------------------------------------
+static void *thread_ir_func (void *arg)
+{
+    struct epoll_event e_event;
+    struct input_event ev[16];
+    int n, i, len;
+
+    // client.cfg RT : rx core 제외
+    rt_profile_worker ();
+
+    while (1) {
+        if ((n = epoll_wait (IR.efd, &e_event, 1, -1)) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        while ((len = read (IR.fd, ev, sizeof(ev))) > 0) {
+            for (i = 0; i < len / (int)sizeof(struct input_event); i++) {
+                // key press only (value 1 = press, 0 = release, 2 = repeat)
+                if ((ev[i].type != EV_KEY) || (ev[i].value != 1))
+                    continue;
+                if (IR.key_code && (ev[i].code != IR.key_code))
+                    continue;
+                ir_event_count ();
+            }
+        }
+        if (!len || ((len < 0) && (errno != EAGAIN))) {
+            printf ("%s : %s read error! (%s)\n", __func__, IR.node,
+                    len ? strerror(errno) : "end of file");
+            break;
+        }
+    }
+    return arg;
+}
+
+//------------------------------------------------------------------------------
+int ir_event_setup (const char *dev_fname)
+{
+    struct epoll_event e_event;
+
+    if (!client_dev_config (dev_fname, "IR", ir_config, NULL) || !IR.pass_count)
+        return 0;
+
+    if (IR.name[0] == '/')
+        strncpy (IR.node, IR.name, sizeof(IR.node) -1);
+    else if (!ir_find_device (IR.name, IR.node)) {
+        printf ("%s : %s input device not found!\n", __func__, IR.name);
+        return 0;
+    }
+
+    if ((IR.fd = open (IR.node, O_RDONLY | O_NONBLOCK)) < 0) {
+        printf ("%s : %s open error!\n", __func__, IR.node);
+        return 0;
+    }
+
+    memset (&e_event, 0, sizeof(e_event));
+    e_event.events = EPOLLIN;   e_event.data.fd = IR.fd;
+
+    if (((IR.efd = epoll_create1 (0)) < 0) ||
+        (epoll_ctl (IR.efd, EPOLL_CTL_ADD, IR.fd, &e_event) < 0)) {
+        printf ("%s : epoll error!\n", __func__);
+        close (IR.fd);  IR.fd = -1;
+        return 0;
+    }
+    ir_event_reset ();
+    pthread_create (&thread_ir, NULL, thread_ir_func, NULL);
+
+    printf ("%s : %s (%s), pass count = %d, key code = %d\n",
+            __func__, IR.name, IR.node, IR.pass_count, IR.key_code);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// return 1 : pass count 도달, 0 : 대기중, -1 : 설정되지 않음 (lib_dev_check 사용)
+//------------------------------------------------------------------------------
+int ir_event_ready (void)
+{
+    if (IR.fd < 0)  return -1;
+
+    return (IR.count >= IR.pass_count);
+}
+
+//------------------------------------------------------------------------------
+// pass count 도달 또는 ms 경과 까지 대기. return : ir_event_ready ()
+//------------------------------------------------------------------------------
+int ir_event_wait (int ms)
+{
+    struct timespec ts;
+
+    if (IR.fd < 0)  return -1;
+
+    clock_gettime (CLOCK_REALTIME, &ts);
+    ts.tv_sec  += ms / 1000;
+    ts.tv_nsec += (ms % 1000) * 1000000;
+    if (ts.tv_nsec >= 1000000000) {
+        ts.tv_sec++;    ts.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock (&IRMutex);
+    while (IR.count < IR.pass_count) {
+        if (pthread_cond_timedwait (&IRCond, &IRMutex, &ts) == ETIMEDOUT)
+            break;
+    }
+    pthread_mutex_unlock (&IRMutex);
+
+    return ir_event_ready ();
+}
+
+//------------------------------------------------------------------------------
+void ir_event_reset (void)
+{
+    pthread_mutex_lock (&IRMutex);
+    IR.count   = 0;
+    IR.lat_min = IR.lat_max = IR.lat_sum = IR.done_us = 0;
+    clock_gettime (CLOCK_MONOTONIC, &IR.t_start);
+    pthread_mutex_unlock (&IRMutex);
+}
+
+//------------------------------------------------------------------------------
+// return 1 : pass, 0 : fail, -1 : 설정되지 않음 (lib_dev_check 사용)
+//------------------------------------------------------------------------------
+int ir_event_check (char *resp)
+{
+    char str[STR_NAME_LENGTH];
+    long lat_avg;
+    int status;
+
+    if ((status = ir_event_ready ()) == -1)
+        return -1;
+
+    pthread_mutex_lock (&IRMutex);
+    lat_avg = (IR.count > 1) ? IR.lat_sum / (IR.count - 1) / 1000 : 0;
+    printf ("%s : count = %d/%d, latency min = %ld ms, avg = %ld ms, max = %ld ms\n",
+            __func__, IR.count, IR.pass_count, IR.lat_min / 1000, lat_avg,
+            IR.lat_max / 1000);
+
+    // count/pass_count 이벤트 간 평균 간격 (ex: "3/3 120ms")
+    snprintf (str, sizeof(str), "%d/%d %ldms", IR.count, IR.pass_count, lat_avg);
+    DEVICE_RESP_FORM_STR (resp, status ? 'P' : 'F', str);
+    pthread_mutex_unlock (&IRMutex);
+
+    return status;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,36 @@
+//------------------------------------------------------------------------------
+/**
+ * @file ir_event.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client IR receiver check (evdev, epoll).
+ * @version 0.1
+ * @date 2025-09-22
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef	__IR_EVENT_H__
+#define	__IR_EVENT_H__
+
+//------------------------------------------------------------------------------
+#define IR_INPUT_CLASS      "/sys/class/input"
+#define IR_INPUT_MAX        32
+
+//------------------------------------------------------------------------------
+// function prototype define
+//------------------------------------------------------------------------------
+extern  int     ir_event_setup  (const char *dev_fname);
+extern  int     ir_event_ready  (void);
+extern  int     ir_event_wait   (int ms);
+extern  void    ir_event_reset  (void);
+extern  int     ir_event_check  (char *resp);
+
+//------------------------------------------------------------------------------
+#endif	// #define	__IR_EVENT_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
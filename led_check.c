@@ -0,0 +1,228 @@
+//------------------------------------------------------------------------------
+/**
+ * @file led_check.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client LED batch check engine.
+ * @version 0.1
+ * @date 2025-09-19
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+//------------------------------------------------------------------------------
+#include "client.h"
+#include "led_check.h"
+
+//------------------------------------------------------------------------------
+//
+// LED 항목은 ON/OFF 각각이 'C' 요청 -> jig pin 측정 -> ack(5초 대기) 로
+// 직렬 처리되어 LED 수 만큼 server round-trip 이 발생함.
+// brightness node 로 제어하는 LED 항목을 하나의 state machine 으로 처리함.
+//   - 서로 다른 제어 node 의 항목은 상태 설정 후 측정 요청 frame 을 연속 전송
+//   - 같은 node 의 항목(같은 LED 의 ON/OFF)은 앞 항목의 ack 수신 즉시 다음 상태로
+//     설정 후 요청 (같은 대기 구간 안에서 처리)
+// protocol 은 frame 당 gid/did 1개 이므로 측정 요청은 항목별 'S' frame 으로 보냄.
+//
+// brightness node 는 setup 시 open 한 fd(sysfs_cache) 로 on/off 값을 write 하고
+// adc_port 측정을 요청함. 그 외 (eth speed, nvme 등) 는 lib_dev_check 의 device_check 가
+// 동기로 처리하므로 batch 에 넣지 않고 check thread 의 기존 방식으로 처리.
+// trigger 는 setup 시 한번만 none 으로 설정함.
+//
+// LED,01,/sys/class/leds/blue/brightness,1,0,P1_6.7,400,100,
+// LED,-1,01,/sys/class/leds/blue/trigger,none,
+//
+//------------------------------------------------------------------------------
+typedef struct led_ch__t {
+    int     enable;
+    int     is_sysfs;       /* brightness node (held fd 로 on/off) */
+    char    path[STR_PATH_LENGTH];
+    char    on [STR_NAME_LENGTH];
+    char    off[STR_NAME_LENGTH];
+    char    port[STR_NAME_LENGTH];
+}   led_ch_t;
+
+static led_ch_t LED_CH[LED_CH_MAX];
+
+/* batch 항목 상태 */
+enum { eLED_PEND, eLED_SENT, eLED_DONE };
+
+//------------------------------------------------------------------------------
+static void led_config (char *line, void *arg)
+{
+    char *item, *trigger;
+    int id;
+
+    (void)arg;
+    if (strtok (line, ",") == NULL)             return;
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+
+    // led config : LED, -1, id, trigger path, trigger value
+    if ((id = atoi (item)) < 0) {
+        if ((item    = strtok (NULL, ",")) == NULL)     return;
+        if ((trigger = strtok (NULL, ",")) == NULL)     return;
+        if ((item    = strtok (NULL, ",")) == NULL)     return;
+
+        /* trigger 는 setup 시 한번만 설정 */
+        if (strncmp (trigger, "/sys/", 5) == 0) {
+            if (sysfs_cache_write (trigger, item) < 0)
+                printf ("%s : %s write error!\n", __func__, trigger);
+        }
+        return;
+    }
+    if (id >= LED_CH_MAX)   return;
+
+    // LED, id, path, on_value, off_value, adc_port, adc_on, adc_off
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+    strncpy (LED_CH[id].path, item, sizeof(LED_CH[id].path) -1);
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+    strncpy (LED_CH[id].on,   item, sizeof(LED_CH[id].on)   -1);
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+    strncpy (LED_CH[id].off,  item, sizeof(LED_CH[id].off)  -1);
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+    strncpy (LED_CH[id].port, item, sizeof(LED_CH[id].port) -1);
+
+    LED_CH[id].is_sysfs = (strstr (LED_CH[id].path, "brightness") != NULL) &&
+                            (sysfs_cache_open (LED_CH[id].path) >= 0);
+    LED_CH[id].enable   = 1;
+}
+
+//------------------------------------------------------------------------------
+int led_check_setup (const char *dev_fname)
+{
+    int cnt;
+
+    memset (LED_CH, 0, sizeof(LED_CH));
+
+    cnt = client_dev_config (dev_fname, "LED", led_config, NULL);
+    printf ("%s : %d led config.\n", __func__, cnt);
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+// brightness node 에 LED 상태 설정 후 측정 요청 (dev_resp)
+//------------------------------------------------------------------------------
+static int led_set (int did, char *dev_resp)
+{
+    led_ch_t *pch = &LED_CH[DEVICE_ID(did)];
+
+    if (sysfs_cache_write (pch->path, (did / 10) ? pch->on : pch->off) < 0) {
+        printf ("%s : %s write error!\n", __func__, pch->path);
+        DEVICE_RESP_FORM_STR (dev_resp, 'F', pch->port);
+        return 0;
+    }
+    DEVICE_RESP_FORM_STR (dev_resp, 'C', pch->port);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// return : batch 로 처리한 항목 수 (0 인 경우 기존 방식으로 처리)
+//------------------------------------------------------------------------------
+int led_check_batch (client_t *p)
+{
+    int batch[LED_BATCH_MAX], state[LED_BATCH_MAX], wait[LED_BATCH_MAX];
+    int cnt, i, j, done, sent;
+    char dev_resp[DEVICE_RESP_SIZE], serial_resp[SERIAL_RESP_SIZE +1];
+    struct timespec ts, te, sent_ts[LED_BATCH_MAX];
+
+    for (i = 0, cnt = 0; (i < p->pui->i_item_cnt) && (cnt < LED_BATCH_MAX); i++) {
+        i_item_t *i_item = &p->pui->i_item[i];
+        int id = DEVICE_ID(i_item->dev_id);
+
+        if ((i_item->grp_id != eGID_LED) || i_item->complete)   continue;
+        if ((id >= LED_CH_MAX) || !LED_CH[id].is_sysfs)         continue;
+
+        // if iperf_value == 0 then skip eth led test
+        if (((id == eLED_100M) || (id == eLED_1G)) && !get_ethernet_iperf())
+            continue;
+
+        state[cnt] = eLED_PEND;     wait[cnt] = 0;
+        batch[cnt++] = i;
+    }
+    if (!cnt)   return 0;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+
+    TRACE_BEGIN (t_ack);
+    for (done = 0; (done != cnt) && !p->stop; ) {
+        /* 제어 node 가 사용중이 아닌 항목의 상태 설정 후 측정 요청 frame 전송 */
+        for (i = 0; i < cnt; i++) {
+            i_item_t *i_item = &p->pui->i_item[batch[i]];
+            int id = DEVICE_ID(i_item->dev_id);
+
+            if ((state[i] != eLED_PEND) || p->stop)     continue;
+            for (j = 0, sent = 0; j < cnt; j++) {
+                int b_id = DEVICE_ID(p->pui->i_item[batch[j]].dev_id);
+                if ((state[j] == eLED_SENT) && !strcmp (LED_CH[b_id].path, LED_CH[id].path))
+                    sent = 1;
+            }
+            if (sent)   continue;
+
+            present_lock ();
+            ui_set_ritem (p->pfb, p->pui, i_item->ui_id, COLOR_YELLOW, -1);
+            present_unlock ();
+
+            clock_gettime (CLOCK_MONOTONIC, &sent_ts[i]);
+            memset (dev_resp, 0, sizeof(dev_resp));
+            i_item->status = led_set (i_item->dev_id, dev_resp);
+
+            SERIAL_RESP_FORM(serial_resp, 'S', eGID_LED, i_item->dev_id, dev_resp);
+            protocol_msg_tx (&p->tport, serial_resp);    protocol_msg_tx (&p->tport, "\r\n");
+
+            state[i] = (dev_resp[0] == 'C') ? eLED_SENT : eLED_DONE;
+            wait [i] = LED_BATCH_WAIT;
+            if (state[i] == eLED_DONE)
+                test_order_time (batch[i], 0);
+        }
+
+        /* ack 대기 (protocol_parse 에서 complete 설정), 항목별 5초 */
+        usleep (FUNC_LOOP_DELAY);
+        for (i = 0, done = 0; i < cnt; i++) {
+            if ((state[i] == eLED_SENT) &&
+                (p->pui->i_item[batch[i]].complete || !--wait[i])) {
+                state[i] = eLED_DONE;
+
+                // client.cfg ORDER : 항목별 검사시간 (측정 요청 -> ack)
+                clock_gettime (CLOCK_MONOTONIC, &te);
+                test_order_time (batch[i], (te.tv_sec - sent_ts[i].tv_sec) * 1000 +
+                                           (te.tv_nsec - sent_ts[i].tv_nsec) / 1000000);
+            }
+            done += (state[i] == eLED_DONE) ? 1 : 0;
+        }
+    }
+    TRACE_END (t_ack, "ack_wait(led batch)");
+    clock_gettime (CLOCK_MONOTONIC, &te);
+
+    for (i = 0, done = 0; i < cnt; i++)
+        done += p->pui->i_item[batch[i]].complete ? 1 : 0;
+
+    printf ("%s : %d/%d led complete, %ld ms\n", __func__, done, cnt,
+            (te.tv_sec - ts.tv_sec) * 1000 + (te.tv_nsec - ts.tv_nsec) / 1000000);
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+// soft reset : batch 중단으로 켜진 채 남은 LED 를 off 로 설정
+//------------------------------------------------------------------------------
+void led_check_reset (void)
+{
+    int id;
+
+    for (id = 0; id < LED_CH_MAX; id++) {
+        if (!LED_CH[id].enable || !LED_CH[id].is_sysfs)  continue;
+        if (sysfs_cache_write (LED_CH[id].path, LED_CH[id].off) < 0)
+            printf ("%s : %s write error!\n", __func__, LED_CH[id].path);
+    }
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,39 @@
+//------------------------------------------------------------------------------
+/**
+ * @file led_check.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client LED batch check engine.
+ * @version 0.1
+ * @date 2025-09-19
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef	__LED_CHECK_H__
+#define	__LED_CHECK_H__
+
+//------------------------------------------------------------------------------
+#define LED_CH_MAX          8
+#define LED_BATCH_MAX       16
+
+/* 항목별 ack 대기시간. 50 * FUNC_LOOP_DELAY(100ms) = 5 sec */
+#define LED_BATCH_WAIT      50
+
+//------------------------------------------------------------------------------
+// function prototype define
+//------------------------------------------------------------------------------
+struct client__t;
+
+extern  int led_check_setup (const char *dev_fname);
+extern  int led_check_batch (struct client__t *p);
+extern  void led_check_reset (void);
+
+//------------------------------------------------------------------------------
+#endif	// #define	__LED_CHECK_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,426 @@
+//------------------------------------------------------------------------------
+/**
+ * @file mem_test.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client memory integrity & bandwidth test.
+ * @version 0.1
+ * @date 2025-09-24
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/sysinfo.h>
+
+//------------------------------------------------------------------------------
+#include "client.h"
+#include "mem_test.h"
+
+//------------------------------------------------------------------------------
+//
+// SYSTEM,4,256,2000,2.0,  (test size MB, time budget ms, min bandwidth GB/s)
+//
+// SYSTEM MEM 항목은 RAM size 만 확인하므로 불량 DRAM 을 검출하지 못함.
+// mlock 된 영역을 core 수 만큼 나누어 각 core 에서 아래 항목을 실행함. (client.cfg RT : rx core 제외)
+//   1. STREAM copy 방식의 bandwidth 측정 (전체 core 동시 실행)
+//   2. address-in-address, moving inversions (time budget 동안 반복)
+// fill/verify kernel 은 gcc vector extension 을 사용하여
+// aarch64 = NEON, x86 = SSE2 로 vector 화 됨.
+//
+//------------------------------------------------------------------------------
+typedef uint64_t vu64_t __attribute__((vector_size(16)));
+
+/* verify/write 를 block 단위로 처리 (1 block = 1KB) */
+#define VEC_BLOCK           64
+#define MEM_BW_LOOPS        4
+
+#define compiler_barrier()  __asm__ __volatile__("" ::: "memory")
+
+typedef struct mem_worker__t {
+    pthread_t   thread;
+    int         cpu;
+    vu64_t      *base;
+    size_t      cnt;        /* vector count (VEC_BLOCK * 2 배수) */
+    long        errors;
+    int         passes;
+}   mem_worker_t;
+
+static struct {
+    int     enable;
+    int     size_mb;
+    int     time_ms;
+    double  min_gbps;
+
+    /* 'R' 마다 gen 증가, 결과는 done_gen == gen 인 경우에만 유효 */
+    volatile int    gen;
+    int     done_gen;
+    int     status;
+    char    resp[DEVICE_RESP_SIZE];
+}   MEM = { 0, DEFAULT_MEM_TEST_MB, DEFAULT_MEM_TEST_MS, 0, 0, -1, 0, {0,} };
+
+static mem_worker_t MemWorker[MEM_TEST_THREAD_MAX];
+static pthread_barrier_t MemBarrier;
+static struct timespec MemDeadline;
+
+/* 실행중인 test 의 gen. reset(gen 변경) 시 deadline 전에 종료 */
+static volatile int MemRunGen;
+
+/* MemStart : worker 생성 완료(barrier 초기화) 까지 대기, MemMutex : check 중복 실행 방지 */
+static pthread_mutex_t MemStart = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t MemMutex = PTHREAD_MUTEX_INITIALIZER;
+
+//------------------------------------------------------------------------------
+static void mem_config (char *line, void *arg)
+{
+    char *item;
+
+    (void)arg;
+    // SYSTEM, did, test size(MB), time budget(ms), min bandwidth(GB/s)
+    if (strtok (line, ",") == NULL)             return;
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+    if (atoi (item) != eSYSTEM_MEM_TEST)        return;
+
+    if ((item = strtok (NULL, ",")) != NULL)    MEM.size_mb  = atoi (item);
+    if ((item = strtok (NULL, ",")) != NULL)    MEM.time_ms  = atoi (item);
+    if ((item = strtok (NULL, ",")) != NULL)    MEM.min_gbps = atof (item);
+    MEM.enable = 1;
+}
+
+//------------------------------------------------------------------------------
+static double diff_sec (struct timespec *ts, struct timespec *te)
+{
+    return (te->tv_sec - ts->tv_sec) + (te->tv_nsec - ts->tv_nsec) / 1e9;
+}
+
+//------------------------------------------------------------------------------
+static int mem_timeout (void)
+{
+    struct timespec now;
+
+    if (MemRunGen != MEM.gen)   return 1;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return diff_sec (&MemDeadline, &now) >= 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// vector kernels
+//------------------------------------------------------------------------------
+static void vec_copy (vu64_t *d, const vu64_t *s, size_t cnt)
+{
+    size_t i;
+
+    for (i = 0; i < cnt; i += 4) {
+        d[i  ] = s[i  ];    d[i+1] = s[i+1];
+        d[i+2] = s[i+2];    d[i+3] = s[i+3];
+    }
+}
+
+//------------------------------------------------------------------------------
+static int vec_is_zero (vu64_t v)
+{
+    return !(v[0] | v[1]);
+}
+
+//------------------------------------------------------------------------------
+static long scalar_count (const vu64_t *p, size_t cnt, vu64_t expect)
+{
+    const uint64_t *w = (const uint64_t *)p;
+    size_t i;
+    long err = 0;
+
+    for (i = 0; i < cnt * 2; i++)
+        err += (w[i] != expect[i & 1]);
+    return err;
+}
+
+//------------------------------------------------------------------------------
+static void vec_fill (vu64_t *p, size_t cnt, vu64_t pat)
+{
+    size_t i;
+
+    for (i = 0; i < cnt; i++)   p[i] = pat;
+}
+
+//------------------------------------------------------------------------------
+// moving inversions : block 단위로 pat 확인 후 next 기록 (up = 1 ascending)
+//------------------------------------------------------------------------------
+static long vec_verify_write (vu64_t *p, size_t cnt, vu64_t pat, vu64_t next, int up)
+{
+    size_t b, i, blocks = cnt / VEC_BLOCK;
+    long err = 0;
+
+    for (b = 0; b < blocks; b++) {
+        vu64_t *blk = p + (up ? b : (blocks - 1 - b)) * VEC_BLOCK;
+        vu64_t diff = { 0, 0 };
+
+        for (i = 0; i < VEC_BLOCK; i++)
+            diff |= blk[i] ^ pat;
+        if (!vec_is_zero (diff))
+            err += scalar_count (blk, VEC_BLOCK, pat);
+
+        if (up) {
+            for (i = 0; i < VEC_BLOCK; i++)     blk[i] = next;
+        } else {
+            for (i = VEC_BLOCK; i > 0; i--)     blk[i-1] = next;
+        }
+    }
+    return err;
+}
+
+//------------------------------------------------------------------------------
+// address-in-address : 각 word 에 자신의 주소를 기록 후 확인
+//------------------------------------------------------------------------------
+static long vec_addr_test (vu64_t *p, size_t cnt)
+{
+    vu64_t addr = { (uint64_t)(uintptr_t)p, (uint64_t)(uintptr_t)p + 8 };
+    const vu64_t step = { sizeof(vu64_t), sizeof(vu64_t) };
+    size_t b, i;
+    long err = 0;
+
+    for (i = 0; i < cnt; i++, addr += step)
+        p[i] = addr;
+
+    compiler_barrier ();
+
+    addr = (vu64_t){ (uint64_t)(uintptr_t)p, (uint64_t)(uintptr_t)p + 8 };
+    for (b = 0; b < cnt; b += VEC_BLOCK) {
+        vu64_t diff = { 0, 0 }, start = addr;
+
+        for (i = 0; i < VEC_BLOCK; i++, addr += step)
+            diff |= p[b + i] ^ addr;
+
+        if (!vec_is_zero (diff)) {
+            for (i = 0; i < VEC_BLOCK; i++, start += step)
+                err += !vec_is_zero (p[b + i] ^ start);
+        }
+    }
+    return err;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static void *thread_mem_func (void *arg)
+{
+    static const uint64_t pattern[] = {
+        0x0000000000000000ULL, 0x5555555555555555ULL,
+        0x3333333333333333ULL, 0x0f0f0f0f0f0f0f0fULL,
+        0x00ff00ff00ff00ffULL, 0x0000ffff0000ffffULL,
+    };
+    mem_worker_t *w = (mem_worker_t *)arg;
+    size_t half = w->cnt / 2;
+    cpu_set_t cpuset;
+    int i;
+
+    CPU_ZERO (&cpuset);     CPU_SET (w->cpu, &cpuset);
+    pthread_setaffinity_np (pthread_self (), sizeof(cpuset), &cpuset);
+
+    /* 생성된 worker 수로 barrier 가 초기화 될 때 까지 대기 */
+    pthread_mutex_lock   (&MemStart);
+    pthread_mutex_unlock (&MemStart);
+
+    /* bandwidth : 전체 core 동시 실행 */
+    pthread_barrier_wait (&MemBarrier);
+    for (i = 0; i < MEM_BW_LOOPS; i++)
+        vec_copy (w->base + half, w->base, half);
+    pthread_barrier_wait (&MemBarrier);
+
+    /* integrity : time budget 까지 반복 (최소 1회) */
+    do {
+        uint64_t v = pattern[w->passes % (sizeof(pattern) / sizeof(pattern[0]))];
+        vu64_t pat = { v, v }, inv = ~pat;
+
+        w->errors += vec_addr_test (w->base, w->cnt);
+
+        vec_fill (w->base, w->cnt, pat);
+        compiler_barrier ();
+        w->errors += vec_verify_write (w->base, w->cnt, pat, inv, 1);
+        compiler_barrier ();
+        w->errors += vec_verify_write (w->base, w->cnt, inv, pat, 0);
+        compiler_barrier ();
+        w->errors += vec_verify_write (w->base, w->cnt, pat, pat, 1);
+
+        w->passes++;
+    }   while (!w->errors && !mem_timeout ());
+
+    return arg;
+}
+
+//------------------------------------------------------------------------------
+static int mem_total_gb (void)
+{
+    struct sysinfo sinfo;
+
+    if (sysinfo (&sinfo) < 0)   return 0;
+
+    return (int)(((uint64_t)sinfo.totalram * sinfo.mem_unit + (1ULL << 29)) >> 30);
+}
+
+//------------------------------------------------------------------------------
+static int mem_test_run (void)
+{
+    struct timespec ts, te;
+    size_t size = (size_t)MEM.size_mb << 20, chunk;
+    int i, n, ncpu, rx_cpu, created, passes = 0, locked;
+    long errors = 0;
+    double gbps, sec;
+    void *region;
+
+    /* client.cfg RT : rx core 제외 */
+    ncpu   = (int)sysconf (_SC_NPROCESSORS_ONLN);
+    ncpu   = (ncpu < 1) ? 1 : ncpu;
+    rx_cpu = rt_profile_rx_cpu ();
+    n = ncpu - ((rx_cpu >= 0) ? 1 : 0);
+    n = (n > MEM_TEST_THREAD_MAX) ? MEM_TEST_THREAD_MAX : n;
+
+    /* core 별 영역 (VEC_BLOCK * 2 vector 단위) */
+    chunk = (size / n) / (sizeof(vu64_t) * VEC_BLOCK * 2) * (VEC_BLOCK * 2);
+    if (!chunk) {
+        printf ("%s : test size error! (%d MB, %d core)\n", __func__, MEM.size_mb, n);
+        MEM.status = 0;
+        snprintf (MEM.resp, sizeof(MEM.resp), "size error");
+        return 0;
+    }
+
+    region = mmap (NULL, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (region == MAP_FAILED) {
+        printf ("%s : mmap error! (%d MB)\n", __func__, MEM.size_mb);
+        return 0;
+    }
+    if (!(locked = (mlock (region, size) == 0)))
+        printf ("%s : mlock error! test continue.\n", __func__);
+
+    clock_gettime (CLOCK_MONOTONIC, &MemDeadline);
+    MemDeadline.tv_sec  += MEM.time_ms / 1000;
+    MemDeadline.tv_nsec += (MEM.time_ms % 1000) * 1000000;
+    if (MemDeadline.tv_nsec >= 1000000000) {
+        MemDeadline.tv_sec++;   MemDeadline.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock (&MemStart);
+    for (i = 0, created = 0; (i < ncpu) && (created < n); i++) {
+        mem_worker_t *w = &MemWorker[created];
+
+        if (i == rx_cpu)    continue;
+        memset (w, 0, sizeof(mem_worker_t));
+        w->cpu  = i;
+        w->base = (vu64_t *)region + chunk * created;
+        w->cnt  = chunk;
+        if (pthread_create (&w->thread, NULL, thread_mem_func, w)) {
+            printf ("%s : cpu %d thread create error!\n", __func__, i);
+            continue;
+        }
+        created++;
+    }
+    if (created)
+        pthread_barrier_init (&MemBarrier, NULL, created + 1);
+    pthread_mutex_unlock (&MemStart);
+
+    if (!created) {
+        if (locked)     munlock (region, size);
+        munmap (region, size);
+        MEM.status = 0;
+        snprintf (MEM.resp, sizeof(MEM.resp), "thread error");
+        return 0;
+    }
+
+    pthread_barrier_wait (&MemBarrier);
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    pthread_barrier_wait (&MemBarrier);
+    clock_gettime (CLOCK_MONOTONIC, &te);
+
+    for (i = 0; i < created; i++) {
+        pthread_join (MemWorker[i].thread, NULL);
+        errors += MemWorker[i].errors;
+        passes += MemWorker[i].passes;
+    }
+    pthread_barrier_destroy (&MemBarrier);
+
+    /* STREAM copy : read + write bytes */
+    sec  = diff_sec (&ts, &te);
+    gbps = (sec > 0) ? (2.0 * (chunk / 2) * sizeof(vu64_t) * MEM_BW_LOOPS * created) / sec / 1e9 : 0;
+
+    if (locked)     munlock (region, size);
+    munmap (region, size);
+
+    MEM.status = !errors && (gbps >= MEM.min_gbps);
+
+    memset (MEM.resp, 0, sizeof(MEM.resp));
+    if (errors)
+        snprintf (MEM.resp, sizeof(MEM.resp), "E%ld/%.1fGB/s", errors, gbps);
+    else
+        snprintf (MEM.resp, sizeof(MEM.resp), "%dG/%.1fGB/s", mem_total_gb (), gbps);
+
+    printf ("%s : %d MB, %d core, %d pass, errors = %ld, copy = %.2f GB/s (min %.2f), %s\n",
+            __func__, MEM.size_mb, created, passes, errors, gbps, MEM.min_gbps,
+            MEM.status ? "PASS" : "FAIL");
+    return MEM.status;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+int mem_test_setup (const char *dev_fname)
+{
+    client_dev_config (dev_fname, "SYSTEM", mem_config, NULL);
+
+    if (MEM.enable)
+        printf ("%s : %d MB, %d ms, min %.2f GB/s\n",
+                __func__, MEM.size_mb, MEM.time_ms, MEM.min_gbps);
+    return MEM.enable;
+}
+
+//------------------------------------------------------------------------------
+// check 실행중 reset 된 경우 test 를 중단하고 해당 결과는 무효 (다음 check 에서 재실행)
+//------------------------------------------------------------------------------
+void mem_test_reset (void)
+{
+    __atomic_add_fetch (&MEM.gen, 1, __ATOMIC_SEQ_CST);
+}
+
+//------------------------------------------------------------------------------
+// return 1 : pass, 0 : fail, -1 : 설정되지 않음, MEM_TEST_RETRY : reset 으로 중단됨
+// 결과는 'R'(re-check) 전까지 유지됨. (ack 대기중 재실행 방지)
+//------------------------------------------------------------------------------
+int mem_test_check (char *resp)
+{
+    int gen, status;
+
+    if (!MEM.enable)    return -1;
+
+    pthread_mutex_lock (&MemMutex);
+    gen = MEM.gen;
+    if (MEM.done_gen != gen) {
+        MemRunGen = gen;
+        mem_test_run ();
+        // 중단된 결과는 사용하지 않음 (done_gen 유지)
+        if (MemRunGen != MEM.gen) {
+            pthread_mutex_unlock (&MemMutex);
+            printf ("%s : reset while running, retry.\n", __func__);
+            return MEM_TEST_RETRY;
+        }
+        MEM.done_gen = gen;
+    }
+    DEVICE_RESP_FORM_STR (resp, MEM.status ? 'P' : 'F', MEM.resp);
+    status = MEM.status;
+    pthread_mutex_unlock (&MemMutex);
+
+    return status;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
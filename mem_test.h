@@ -0,0 +1,43 @@
+//------------------------------------------------------------------------------
+/**
+ * @file mem_test.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client memory integrity & bandwidth test.
+ * @version 0.1
+ * @date 2025-09-24
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef	__MEM_TEST_H__
+#define	__MEM_TEST_H__
+
+//------------------------------------------------------------------------------
+/* lib_dev_check 의 SYSTEM did (MEM, FB_X, FB_Y, FB_SIZE) 다음 항목 */
+#define eSYSTEM_MEM_TEST    (eSYSTEM_FB_SIZE + 1)
+
+#define MEM_TEST_THREAD_MAX 16
+
+/* mem_test_check : 실행중 reset 되어 결과 없음 (다음 check 에서 재실행) */
+#define MEM_TEST_RETRY      -2
+
+/* dev cfg 설정이 없는 경우 기본값 */
+#define DEFAULT_MEM_TEST_MB     256
+#define DEFAULT_MEM_TEST_MS     2000
+
+//------------------------------------------------------------------------------
+// function prototype define
+//------------------------------------------------------------------------------
+extern  int     mem_test_setup  (const char *dev_fname);
+extern  void    mem_test_reset  (void);
+extern  int     mem_test_check  (char *resp);
+
+//------------------------------------------------------------------------------
+#endif	// #define	__MEM_TEST_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
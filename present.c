@@ -0,0 +1,363 @@
+//------------------------------------------------------------------------------
+/**
+ * @file present.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client off-screen rendering & fb present (page flip / damage).
+ * @version 0.1
+ * @date 2025-10-03
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/fb.h>
+
+//------------------------------------------------------------------------------
+#include "present.h"
+
+//------------------------------------------------------------------------------
+//
+// ui cfg
+//   D, 0,  : direct (lib_fbui 가 화면 memory 에 직접 출력)
+//   D, 1,  : page flip. yres_virtual >= yres * 2 인 경우 숨겨진 page 에 frame 을 copy 후
+//            FBIOPAN_DISPLAY + FBIO_WAITFORVSYNC 로 전환. 불가시 damage 로 동작.
+//   D, 2,  : damage. 이전 present 와 다른 tile(PRESENT_TILE_W x PRESENT_TILE_H) 만
+//            vsync 후 화면 memory 에 copy.
+//
+// flip/damage mode 에서는 pfb->data 를 off-screen back buffer 로 교체하므로
+// 모든 thread 의 ui_set_xxx/ui_update 출력은 back buffer 에 그려지고,
+// thread_ui_func 에서 present_update() 호출시에만 화면에 반영됨.
+// back buffer 에 그리는 동안 copy 되지 않도록 ui_set_xxx/ui_update 는
+// present_lock()/present_unlock() 안에서 호출함. (direct mode 에서는 lock 하지 않음)
+// lock 은 back buffer copy 동안만 잡고 vsync 대기는 lock 밖에서 함.
+// (RT RX thread 가 UI 출력 중 lock 을 기다리는 경우를 위해 PTHREAD_PRIO_INHERIT 사용)
+//
+// page flip 은 fb 의 yres_virtual 이 이미 2 page 이상인 경우에만 사용함.
+// (FBIOPUT_VSCREENINFO 로 변경시 lib_fbui mapping 및 SYSTEM fb virtual_size 검사에 영향)
+//
+//------------------------------------------------------------------------------
+static const char *PresentName[ePRESENT_END] = { "direct", "flip", "damage" };
+
+static struct {
+    int     mode;
+    char    *screen;        /* lib_fbui 의 fb mapping (page 0) */
+    char    *back;          /* off-screen render buffer (pfb->data) */
+    char    *prev;          /* damage : 마지막으로 present 한 frame */
+    char    *dirty;         /* damage : 변경된 tile (prev 에 복사 후 화면으로 copy) */
+    int     tiles_w, tiles_h;
+    int     size;           /* 1 page size (stride * h) */
+
+    /* flip */
+    char    *vmem;          /* 전체 page mapping */
+    int     vmem_size;
+    int     page;           /* 현재 표시중인 page */
+    struct fb_var_screeninfo    var;
+    int     vsync;          /* FBIO_WAITFORVSYNC 지원 */
+    int     pan_err;
+
+    /* report */
+    long    cnt, updates;   /* flip 횟수 / copy 한 tile 수 */
+    long    lat_ns, lat_max_ns;
+}   Present;
+
+static pthread_mutex_t PresentMutex = PTHREAD_MUTEX_INITIALIZER;
+
+//------------------------------------------------------------------------------
+static int present_config (const char *ui_fname)
+{
+    FILE *fp;
+    char buf[256], *tok;
+    int mode = ePRESENT_DIRECT;
+
+    if ((ui_fname == NULL) || ((fp = fopen (ui_fname, "r")) == NULL))
+        return mode;
+
+    while (fgets (buf, sizeof(buf), fp) != NULL) {
+        if ((buf[0] != 'D') || (strtok (buf, ",") == NULL))
+            continue;
+        if ((tok = strtok (NULL, ",")) != NULL)
+            mode = atoi (tok);
+    }
+    fclose (fp);
+
+    return ((mode < 0) || (mode >= ePRESENT_END)) ? ePRESENT_DIRECT : mode;
+}
+
+//------------------------------------------------------------------------------
+static int present_wait_vsync (fb_info_t *pfb)
+{
+    int arg = 0;
+
+    if (!Present.vsync)     return 0;
+    if (ioctl (pfb->fd, FBIO_WAITFORVSYNC, &arg) < 0) {
+        Present.vsync = 0;
+        return 0;
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// virtual resolution 이 2 page 이상인 경우 전체 page mapping
+//------------------------------------------------------------------------------
+static int present_flip_setup (fb_info_t *pfb)
+{
+    struct fb_fix_screeninfo fix;
+    struct fb_var_screeninfo var;
+
+    if (ioctl (pfb->fd, FBIOGET_VSCREENINFO, &var) < 0)     return 0;
+
+    if (var.yres_virtual < var.yres * 2) {
+        printf ("%s : yres_virtual = %d, page flip not supported.\n",
+                __func__, var.yres_virtual);
+        return 0;
+    }
+    if (ioctl (pfb->fd, FBIOGET_FSCREENINFO, &fix) < 0)     return 0;
+    if ((int)fix.smem_len < Present.size * 2)               return 0;
+
+    Present.vmem_size = Present.size * 2;
+    Present.vmem = mmap (NULL, Present.vmem_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, pfb->fd, 0);
+    if (Present.vmem == MAP_FAILED) {
+        Present.vmem = NULL;
+        return 0;
+    }
+    Present.var  = var;
+    Present.page = (var.yoffset >= var.yres) ? 1 : 0;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+int present_setup (fb_info_t *pfb, const char *ui_fname)
+{
+    pthread_mutexattr_t attr;
+
+    /* thread 생성 전 1회 호출 */
+    pthread_mutexattr_init (&attr);
+    pthread_mutexattr_setprotocol (&attr, PTHREAD_PRIO_INHERIT);
+    pthread_mutex_init (&PresentMutex, &attr);
+    pthread_mutexattr_destroy (&attr);
+
+    pthread_mutex_lock (&PresentMutex);
+    memset (&Present, 0, sizeof(Present));
+
+    Present.mode   = present_config (ui_fname);
+    Present.screen = pfb->data;
+    Present.size   = pfb->stride * pfb->h;
+    Present.vsync  = 1;
+
+    if (Present.mode == ePRESENT_DIRECT)
+        goto out;
+
+    if ((Present.back = malloc (Present.size)) == NULL) {
+        Present.mode = ePRESENT_DIRECT;
+        goto out;
+    }
+    if ((Present.mode == ePRESENT_FLIP) && !present_flip_setup (pfb))
+        Present.mode = ePRESENT_DAMAGE;
+
+    if (Present.mode == ePRESENT_DAMAGE) {
+        Present.tiles_w = (pfb->w + PRESENT_TILE_W -1) / PRESENT_TILE_W;
+        Present.tiles_h = (pfb->h + PRESENT_TILE_H -1) / PRESENT_TILE_H;
+        Present.prev    = malloc (Present.size);
+        Present.dirty   = malloc (Present.tiles_w * Present.tiles_h);
+        if ((Present.prev == NULL) || (Present.dirty == NULL)) {
+            free (Present.back);    Present.back = NULL;
+            free (Present.prev);    Present.prev = NULL;
+            free (Present.dirty);   Present.dirty = NULL;
+            Present.mode = ePRESENT_DIRECT;
+            goto out;
+        }
+    }
+
+    /* 현재 화면을 back buffer 로 복사 후 lib_fbui 출력 대상 변경 */
+    if (Present.vmem)
+        memcpy (Present.back, Present.vmem + Present.page * Present.size, Present.size);
+    else
+        memcpy (Present.back, Present.screen, Present.size);
+    if (Present.prev)   memcpy (Present.prev, Present.screen, Present.size);
+    pfb->data = Present.back;
+out:
+    pthread_mutex_unlock (&PresentMutex);
+
+    printf ("%s : mode = %s, %dx%d %dbpp, vsync %s\n", __func__,
+            PresentName[Present.mode], pfb->w, pfb->h, pfb->bpp,
+            (Present.mode == ePRESENT_DIRECT) ? "-" : "auto");
+    return Present.mode;
+}
+
+//------------------------------------------------------------------------------
+// PresentMutex 안에서 호출. return 1 : page 전환 (lock 밖에서 vsync 대기)
+//------------------------------------------------------------------------------
+static int present_flip (fb_info_t *pfb)
+{
+    int next = !Present.page;
+
+    memcpy (Present.vmem + next * Present.size, Present.back, Present.size);
+
+    Present.var.xoffset = 0;
+    Present.var.yoffset = next * Present.var.yres;
+    if (ioctl (pfb->fd, FBIOPAN_DISPLAY, &Present.var) < 0) {
+        if (!Present.pan_err++)
+            printf ("%s : FBIOPAN_DISPLAY error! (copy to visible page)\n", __func__);
+        /* 표시중인 page 에 그대로 출력 */
+        memcpy (Present.vmem + Present.page * Present.size, Present.back, Present.size);
+        return 0;
+    }
+    Present.page = next;
+    Present.updates++;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// PresentMutex 안에서 호출. 변경된 tile 을 prev 에 복사하고 dirty 표시.
+// return : 변경된 tile 수
+//------------------------------------------------------------------------------
+static int present_damage_stage (fb_info_t *pfb)
+{
+    int tx, ty, y, bpp = pfb->bpp / 8, cnt = 0;
+    char *dirty = Present.dirty;
+
+    for (ty = 0; ty < pfb->h; ty += PRESENT_TILE_H) {
+        int th = ((ty + PRESENT_TILE_H) > pfb->h) ? (pfb->h - ty) : PRESENT_TILE_H;
+
+        for (tx = 0; tx < pfb->w; tx += PRESENT_TILE_W, dirty++) {
+            int tw  = ((tx + PRESENT_TILE_W) > pfb->w) ? (pfb->w - tx) : PRESENT_TILE_W;
+            int off = ty * pfb->stride + tx * bpp, len = tw * bpp;
+
+            for (y = 0; y < th; y++, off += pfb->stride)
+                if (memcmp (Present.back + off, Present.prev + off, len))
+                    break;
+            if ((*dirty = (y != th)) == 0)  continue;
+
+            for (y = 0, off = ty * pfb->stride + tx * bpp; y < th; y++, off += pfb->stride)
+                memcpy (Present.prev + off, Present.back + off, len);
+            cnt++;
+        }
+    }
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+// lock 밖에서 호출 (prev/dirty 는 present_update 에서만 사용)
+//------------------------------------------------------------------------------
+static void present_damage_copy (fb_info_t *pfb)
+{
+    int tx, ty, y, bpp = pfb->bpp / 8;
+    char *dirty = Present.dirty;
+
+    for (ty = 0; ty < pfb->h; ty += PRESENT_TILE_H) {
+        int th = ((ty + PRESENT_TILE_H) > pfb->h) ? (pfb->h - ty) : PRESENT_TILE_H;
+
+        for (tx = 0; tx < pfb->w; tx += PRESENT_TILE_W, dirty++) {
+            int tw  = ((tx + PRESENT_TILE_W) > pfb->w) ? (pfb->w - tx) : PRESENT_TILE_W;
+            int off = ty * pfb->stride + tx * bpp, len = tw * bpp;
+
+            if (!*dirty)    continue;
+            for (y = 0; y < th; y++, off += pfb->stride)
+                memcpy (Present.screen + off, Present.prev + off, len);
+            Present.updates++;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// back buffer 출력 (ui_set_xxx, ui_update) 과 present copy 의 동기화
+//------------------------------------------------------------------------------
+void present_lock (void)
+{
+    if (Present.mode == ePRESENT_DIRECT)    return;
+
+    pthread_mutex_lock (&PresentMutex);
+    /* 대기 중 present_close 로 direct 로 변경된 경우 */
+    if (Present.mode == ePRESENT_DIRECT)
+        pthread_mutex_unlock (&PresentMutex);
+}
+
+//------------------------------------------------------------------------------
+void present_unlock (void)
+{
+    if (Present.mode == ePRESENT_DIRECT)    return;
+
+    pthread_mutex_unlock (&PresentMutex);
+}
+
+//------------------------------------------------------------------------------
+void present_update (fb_info_t *pfb)
+{
+    struct timespec ts, te;
+    long ns;
+    int changed;
+
+    if (Present.mode == ePRESENT_DIRECT)    return;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+
+    /* back buffer copy 동안만 lock */
+    pthread_mutex_lock (&PresentMutex);
+    if (Present.mode == ePRESENT_FLIP)  changed = present_flip         (pfb);
+    else                                changed = present_damage_stage (pfb);
+    pthread_mutex_unlock (&PresentMutex);
+
+    if (changed) {
+        /* flip : 이전 page 가 scan-out 에서 빠질 때 까지 대기
+           damage : scan-out 중 copy 방지 */
+        present_wait_vsync (pfb);
+        if (Present.mode == ePRESENT_DAMAGE)
+            present_damage_copy (pfb);
+    }
+    clock_gettime (CLOCK_MONOTONIC, &te);
+    ns = (te.tv_sec - ts.tv_sec) * 1000000000L + (te.tv_nsec - ts.tv_nsec);
+
+    Present.cnt++;
+    Present.lat_ns += ns;
+    if (ns > Present.lat_max_ns)    Present.lat_max_ns = ns;
+
+    if (!(Present.cnt % PRESENT_REPORT_CNT))
+        present_report ();
+}
+
+//------------------------------------------------------------------------------
+void present_report (void)
+{
+    if ((Present.mode == ePRESENT_DIRECT) || !Present.cnt)  return;
+
+    printf ("%s : %s, %ld present, latency avg = %ld us, max = %ld us, %s = %ld\n",
+            __func__, PresentName[Present.mode], Present.cnt,
+            Present.lat_ns / Present.cnt / 1000, Present.lat_max_ns / 1000,
+            (Present.mode == ePRESENT_FLIP) ? "flips" : "tiles", Present.updates);
+}
+
+//------------------------------------------------------------------------------
+void present_close (fb_info_t *pfb)
+{
+    pthread_mutex_lock (&PresentMutex);
+    if (Present.mode != ePRESENT_DIRECT) {
+        /* 마지막 frame 을 page 0 에 출력 후 원래 mapping 으로 복원 */
+        memcpy (Present.screen, Present.back, Present.size);
+        if (Present.vmem) {
+            Present.var.yoffset = 0;
+            ioctl (pfb->fd, FBIOPAN_DISPLAY, &Present.var);
+            munmap (Present.vmem, Present.vmem_size);
+        }
+        pfb->data = Present.screen;
+        free (Present.back);
+        free (Present.prev);
+        free (Present.dirty);
+    }
+    memset (&Present, 0, sizeof(Present));
+    pthread_mutex_unlock (&PresentMutex);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
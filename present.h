@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------------
+/**
+ * @file present.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client off-screen rendering & fb present (page flip / damage).
+ * @version 0.1
+ * @date 2025-10-03
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef	__PRESENT_H__
+#define	__PRESENT_H__
+
+#include "lib_fbui/lib_fb.h"
+
+//------------------------------------------------------------------------------
+/* ui cfg 'D' line : D, mode, */
+enum {
+    ePRESENT_DIRECT = 0,    /* 기존 방식 (/dev/fb 에 직접 출력) */
+    ePRESENT_FLIP,          /* back buffer + FBIOPAN_DISPLAY (yres_virtual 2 page 이상, 불가시 damage) */
+    ePRESENT_DAMAGE,        /* back buffer + 변경된 tile 만 copy */
+    ePRESENT_END
+};
+
+/* damage 비교 단위 (pixel) */
+#define PRESENT_TILE_W      64
+#define PRESENT_TILE_H      16
+
+/* present latency report 주기 (present 횟수) */
+#define PRESENT_REPORT_CNT  120
+
+//------------------------------------------------------------------------------
+// function prototype define
+//------------------------------------------------------------------------------
+extern  int     present_setup   (fb_info_t *pfb, const char *ui_fname);
+extern  void    present_lock    (void);
+extern  void    present_unlock  (void);
+extern  void    present_update  (fb_info_t *pfb);
+extern  void    present_report  (void);
+extern  void    present_close   (fb_info_t *pfb);
+
+//------------------------------------------------------------------------------
+#endif	// #define	__PRESENT_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -23,6 +23,8 @@
 //------------------------------------------------------------------------------
 /* protocol control 함수 */
 #include "protocol.h"
+#include "session.h"
+#include "rt_profile.h"
 
 //------------------------------------------------------------------------------
 //
@@ -38,39 +40,92 @@ int protocol_check (ptc_var_t *var)
 }
 
 //------------------------------------------------------------------------------
-int protocol_catch (ptc_var_t *var)
+static int protocol_cmd (char cmd)
 {
-    char cmd = var->buf[(var->p_sp + 2) % var->size];
-
     switch (cmd) {
         case 'B': case 'R':
         case 'A': case 'O': case 'C':
         case 'E': case 'X':
             return 1;
         default :
-            printf ("unknown command %c\n", cmd);
             return 0;
     }
 }
 
 //------------------------------------------------------------------------------
-void protocol_msg_tx (uart_t *puart, void *tx_msg)
+int protocol_catch (ptc_var_t *var)
 {
-    if (puart == NULL)  return;
+    char cmd = var->buf[(var->p_sp + 2) % var->size];
+
+    if (!protocol_cmd (cmd)) {
+        printf ("unknown command %c\n", cmd);
+        return 0;
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// socket 수신 data 의 frame 처리 (UART ptc_event 와 같은 방식)
+//------------------------------------------------------------------------------
+static int protocol_frame (transport_t *pt, unsigned char idata, char *rx_msg)
+{
+    unsigned int i, size = SERIAL_RESP_SIZE;
+
+    if (pt->cnt < size)
+        pt->rbuf[(pt->p_sp + pt->cnt++) % size] = idata;
+    else {
+        pt->rbuf[pt->p_sp] = idata;
+        pt->p_sp = (pt->p_sp + 1) % size;
+    }
+    if (pt->cnt != size)    return 0;
 
-    uart_write (puart, tx_msg, (int)strlen(tx_msg));
+    /* head & tail, command check */
+    if (pt->rbuf[(pt->p_sp + size -1) % size] != '#')   return 0;
+    if (pt->rbuf[(pt->p_sp          ) % size] != '@')   return 0;
+    if (!protocol_cmd (pt->rbuf[(pt->p_sp + 2) % size]))    return 0;
+
+    for (i = 0; i < size; i++)
+        rx_msg [i] = pt->rbuf[(pt->p_sp + i) % size];
+
+    pt->cnt = pt->p_sp = 0;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+void protocol_msg_tx (transport_t *pt, void *tx_msg)
+{
+    if (pt == NULL)  return;
+
+    transport_write (pt, tx_msg, (int)strlen(tx_msg));
+    session_record  (SESSION_TX, tx_msg, (int)strlen(tx_msg));
     printf ("%s : size = %d, data = %s\n", __func__, (int)strlen(tx_msg), (char *)tx_msg);
 }
 
 //------------------------------------------------------------------------------
-int protocol_msg_rx (uart_t *puart, char *rx_msg)
+int protocol_msg_rx (transport_t *pt, char *rx_msg)
 {
     unsigned char idata, p_cnt;
+    uart_t *puart;
+    int drain;
 
-    if (puart == NULL)  return 0;
+    if (pt == NULL)  return 0;
 
-    /* uart data processing */
-    if (uart_read (puart, &idata, 1)) {
+    /* socket data processing */
+    while (transport_read (pt, &idata)) {
+        if (idata == '@')   rt_latency_rx ();
+        if (protocol_frame (pt, idata, rx_msg)) {
+            session_record (SESSION_RX, rx_msg, SERIAL_RESP_SIZE);
+            return 1;
+        }
+    }
+
+    if (((puart = pt->puart) == NULL) || session_replay_active ())
+        return 0;
+
+    /* uart data processing (client.cfg RT : 수신된 data 를 모두 처리, frame 완성시 return) */
+    drain = rt_profile_active ();
+    while (uart_read (puart, &idata, 1)) {
+        if (idata == '@')   rt_latency_rx ();
         ptc_event (puart, idata);
         for (p_cnt = 0; p_cnt < puart->pcnt; p_cnt++) {
             if (puart->p[p_cnt].var.pass) {
@@ -83,9 +138,13 @@ int protocol_msg_rx (uart_t *puart, char *rx_msg)
                 for (i = 0; i < (int)var->size; i++)
                     // uuid start position is 2
                     rx_msg [i] = var->buf[(var->p_sp + i) % var->size];
+
+                session_record (SESSION_RX, rx_msg, var->size);
                 return 1;
             }
         }
+        /* 기존 방식 : loop 당 1 byte */
+        if (!drain)     break;
     }
     return 0;
 }
@@ -17,14 +17,15 @@
 #define	__PROTOCOL_H__
 
 #include "lib_uart/lib_uart.h"
+#include "transport.h"
 
 //------------------------------------------------------------------------------
 // function prototype define
 //------------------------------------------------------------------------------
 extern  int     protocol_catch  (ptc_var_t *var);
 extern  int     protocol_check  (ptc_var_t *var);
-extern  void    protocol_msg_tx (uart_t *puart, void *tx_msg);
-extern  int     protocol_msg_rx (uart_t *puart, char *rx_msg);
+extern  void    protocol_msg_tx (transport_t *pt, void *tx_msg);
+extern  int     protocol_msg_rx (transport_t *pt, char *rx_msg);
 
 //------------------------------------------------------------------------------
 #endif	// #define	__PROTOCOL_H__
@@ -0,0 +1,227 @@
+//------------------------------------------------------------------------------
+/**
+ * @file rt_profile.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client real-time scheduling profile for the RX path.
+ * @version 0.1
+ * @date 2025-10-08
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+//------------------------------------------------------------------------------
+#include "rt_profile.h"
+
+//------------------------------------------------------------------------------
+//
+// client.cfg
+//   RT,1,50,-1,
+//
+// enable 인 경우
+//   main thread (RX loop + protocol_parse) : SCHED_FIFO(priority), rx core 에 고정
+//   thread_ui, thread_check, thread_ir     : rx core 를 제외한 core 에 고정
+//   lib_fbui, lib_dev_check thread         : client_setup 에서 main 을 먼저 worker core 로 제한 (상속)
+//   mem test worker                        : rx core 를 제외한 core 에서 실행
+//   mlockall (MCL_CURRENT | MCL_FUTURE), main stack prefault
+//   RX loop 는 수신된 data 를 모두 처리하고 frame 처리 후 sleep 하지 않음.
+//   (disable 인 경우 기존 방식 : loop 당 UART 1 byte, frame 처리 후 sleep)
+//
+// RX latency 는 profile 사용 여부와 관계없이 측정함. ('E' command 시 출력)
+//   wakeup   : RX loop 의 usleep 요청 시간 대비 지연
+//   dispatch : frame 첫 byte('@') read ~ protocol_parse 완료.
+//
+//------------------------------------------------------------------------------
+static struct {
+    int     enable, prio, cpu;
+    int     active;
+}   RT = { 0, RT_DEFAULT_PRIO, -1, 0 };
+
+static struct {
+    struct timespec sleep;      /* 마지막 sleep 시작 */
+    struct timespec rx;         /* 마지막 frame 첫 byte read */
+    int     rx_valid;
+    int     sleep_us;
+    long    wake_cnt, wake_ns, wake_max_ns;
+    long    frame_cnt, frame_ns, frame_max_ns;
+}   Lat;
+
+//------------------------------------------------------------------------------
+static long elapsed_ns (struct timespec *ts)
+{
+    struct timespec now;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - ts->tv_sec) * 1000000000L + (now.tv_nsec - ts->tv_nsec);
+}
+
+//------------------------------------------------------------------------------
+// RT, enable, priority, rx core,
+//------------------------------------------------------------------------------
+void rt_profile_config (char *line)
+{
+    char *item;
+
+    if (strtok (line, ",") == NULL)             return;
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+    RT.enable = atoi (item);
+    if ((item = strtok (NULL, ",")) != NULL)
+        RT.prio = atoi (item);
+    if ((item = strtok (NULL, ",\n")) != NULL)
+        RT.cpu  = atoi (item);
+
+    if ((RT.prio < 1) || (RT.prio > 99))
+        RT.prio = RT_DEFAULT_PRIO;
+}
+
+//------------------------------------------------------------------------------
+// main thread 에서 worker thread 생성 후 호출 (SCHED_FIFO 가 상속되지 않도록)
+//------------------------------------------------------------------------------
+int rt_profile_rx (void)
+{
+    struct sched_param param;
+    cpu_set_t cpuset;
+    int ncpu = sysconf (_SC_NPROCESSORS_ONLN);
+
+    if (!RT.enable)     return 0;
+
+    if ((RT.cpu < 0) || (RT.cpu >= ncpu))
+        RT.cpu = ncpu - 1;
+
+    if (mlockall (MCL_CURRENT | MCL_FUTURE) < 0)
+        printf ("%s : mlockall error! (RLIMIT_MEMLOCK)\n", __func__);
+
+    /* RX 중 stack page fault 방지 */
+    {
+        volatile char stack[RT_STACK_PREFAULT];
+        memset ((char *)stack, 0, sizeof(stack));
+    }
+
+    CPU_ZERO (&cpuset);     CPU_SET (RT.cpu, &cpuset);
+    if (pthread_setaffinity_np (pthread_self (), sizeof(cpuset), &cpuset))
+        printf ("%s : cpu %d affinity error!\n", __func__, RT.cpu);
+
+    memset (&param, 0, sizeof(param));
+    param.sched_priority = RT.prio;
+    if (pthread_setschedparam (pthread_self (), SCHED_FIFO, &param)) {
+        printf ("%s : SCHED_FIFO error! (root or CAP_SYS_NICE)\n", __func__);
+        return 0;
+    }
+    RT.active = 1;
+
+    printf ("%s : rx thread SCHED_FIFO(%d), cpu %d / %d\n", __func__, RT.prio, RT.cpu, ncpu);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// return 1 : RX thread SCHED_FIFO 동작중
+//------------------------------------------------------------------------------
+int rt_profile_active (void)
+{
+    return RT.active;
+}
+
+//------------------------------------------------------------------------------
+// return : worker 에서 제외할 rx core, -1 : 제외 안함 (disable 또는 single core)
+//------------------------------------------------------------------------------
+int rt_profile_rx_cpu (void)
+{
+    int ncpu = sysconf (_SC_NPROCESSORS_ONLN);
+
+    if (!RT.enable || (ncpu < 2))   return -1;
+
+    return ((RT.cpu < 0) || (RT.cpu >= ncpu)) ? (ncpu - 1) : RT.cpu;
+}
+
+//------------------------------------------------------------------------------
+// worker thread 는 rx core 를 제외한 core 에서 실행
+//------------------------------------------------------------------------------
+void rt_profile_worker (void)
+{
+    cpu_set_t cpuset;
+    int i, rx_cpu, ncpu = sysconf (_SC_NPROCESSORS_ONLN);
+
+    if ((rx_cpu = rt_profile_rx_cpu ()) < 0)    return;
+
+    CPU_ZERO (&cpuset);
+    for (i = 0; i < ncpu; i++)
+        if (i != rx_cpu)    CPU_SET (i, &cpuset);
+
+    pthread_setaffinity_np (pthread_self (), sizeof(cpuset), &cpuset);
+}
+
+//------------------------------------------------------------------------------
+// RX loop delay. 요청 시간 대비 wakeup 지연 측정.
+//------------------------------------------------------------------------------
+void rt_latency_sleep (int usec)
+{
+    long late;
+
+    clock_gettime (CLOCK_MONOTONIC, &Lat.sleep);
+    Lat.sleep_us = usec;
+    usleep (usec);
+
+    late = elapsed_ns (&Lat.sleep) - usec * 1000L;
+    if (late < 0)   late = 0;
+
+    Lat.wake_cnt++;
+    Lat.wake_ns += late;
+    if (late > Lat.wake_max_ns)     Lat.wake_max_ns = late;
+}
+
+//------------------------------------------------------------------------------
+// frame 첫 byte ('@') read 시점 기록
+//------------------------------------------------------------------------------
+void rt_latency_rx (void)
+{
+    clock_gettime (CLOCK_MONOTONIC, &Lat.rx);
+    Lat.rx_valid = 1;
+}
+
+//------------------------------------------------------------------------------
+// protocol_parse 완료시 호출 (첫 byte read ~ dispatch)
+//------------------------------------------------------------------------------
+void rt_latency_dispatch (void)
+{
+    long ns;
+
+    if (!Lat.rx_valid)  return;
+    Lat.rx_valid = 0;
+
+    ns = elapsed_ns (&Lat.rx);
+    Lat.frame_cnt++;
+    Lat.frame_ns += ns;
+    if (ns > Lat.frame_max_ns)      Lat.frame_max_ns = ns;
+}
+
+//------------------------------------------------------------------------------
+void rt_latency_report (void)
+{
+    printf ("%s : rt profile %s", __func__, RT.active ? "active" : "disable");
+    if (RT.active)
+        printf (" (SCHED_FIFO %d, cpu %d)", RT.prio, RT.cpu);
+    printf ("\n");
+
+    printf ("%s : wakeup   avg = %ld us, max = %ld us (%ld loops, %d us period)\n",
+            __func__, Lat.wake_cnt ? Lat.wake_ns / Lat.wake_cnt / 1000 : 0,
+            Lat.wake_max_ns / 1000, Lat.wake_cnt, Lat.sleep_us);
+    printf ("%s : dispatch avg = %ld us, max = %ld us (%ld frames)\n",
+            __func__, Lat.frame_cnt ? Lat.frame_ns / Lat.frame_cnt / 1000 : 0,
+            Lat.frame_max_ns / 1000, Lat.frame_cnt);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
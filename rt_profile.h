@@ -0,0 +1,44 @@
+//------------------------------------------------------------------------------
+/**
+ * @file rt_profile.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client real-time scheduling profile for the RX path.
+ * @version 0.1
+ * @date 2025-10-08
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef	__RT_PROFILE_H__
+#define	__RT_PROFILE_H__
+
+//------------------------------------------------------------------------------
+/* client.cfg : RT, enable, priority(1~99), rx core(-1 = 마지막 core), */
+#define RT_DEFAULT_PRIO     50
+
+/* mlockall 후 미리 page fault 처리할 stack 크기 */
+#define RT_STACK_PREFAULT   (256 * 1024)
+
+//------------------------------------------------------------------------------
+// function prototype define
+//------------------------------------------------------------------------------
+extern  void    rt_profile_config   (char *line);
+extern  int     rt_profile_rx       (void);
+extern  void    rt_profile_worker   (void);
+extern  int     rt_profile_active   (void);
+extern  int     rt_profile_rx_cpu   (void);
+
+extern  void    rt_latency_sleep    (int usec);
+extern  void    rt_latency_rx       (void);
+extern  void    rt_latency_dispatch (void);
+extern  void    rt_latency_report   (void);
+
+//------------------------------------------------------------------------------
+#endif	// #define	__RT_PROFILE_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,312 @@
+//------------------------------------------------------------------------------
+/**
+ * @file session.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client protocol session record & replay.
+ * @version 0.1
+ * @date 2025-09-29
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+#include "session.h"
+
+//------------------------------------------------------------------------------
+//
+// record (-c {file}) : protocol_msg_rx()/protocol_msg_tx() 의 모든 frame 을
+//                      monotonic timestamp 와 함께 binary 파일로 저장.
+// replay (-r {file}) : 저장된 RX frame 을 transport 대신 protocol_parse() 로 전달.
+//                      -x {speed} : 1 = 실시간, N = N배속, 0 = 최대속도
+//                      저장된 TX frame 은 session_replay_tx() 로 찾아 device 검사 결과 대신
+//                      사용함. (hardware 상태와 관계없이 같은 결과로 replay)
+//
+// file format (little endian)
+//   header : "JIGS", u16 version, u16 reserved
+//   record : u32 delta_us (이전 record 부터 시간), u8 dir ('R'/'T'), u8 size, data[size]
+//
+//------------------------------------------------------------------------------
+typedef struct session_hdr__t {
+    char        magic[4];
+    uint16_t    version;
+    uint16_t    reserved;
+}   __attribute__((packed)) session_hdr_t;
+
+typedef struct session_rec__t {
+    uint32_t    delta_us;
+    uint8_t     dir;
+    uint8_t     size;
+}   __attribute__((packed)) session_rec_t;
+
+//------------------------------------------------------------------------------
+typedef struct session_tx__t {
+    int     size, used;
+    char    data[256];
+}   session_tx_t;
+
+//------------------------------------------------------------------------------
+static FILE *RecFp = NULL;
+static struct timespec RecLast;
+static pthread_mutex_t RecMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static struct {
+    FILE    *fp;
+    int     speed;
+    int     done;
+
+    /* 다음 RX frame (due_us 에 전달) */
+    int     pending;
+    uint64_t        due_us;
+    unsigned char   buf[256];
+    int     pos, size;
+
+    int     started;
+    struct timespec start;
+    long    frames, bytes;
+    long    parse_ns, parse_max_ns;
+
+    /* 기록된 TX frame (session_replay_tx) */
+    session_tx_t    *tx;
+    int     tx_cnt;
+}   Play;
+
+static pthread_mutex_t PlayTxMutex = PTHREAD_MUTEX_INITIALIZER;
+
+//------------------------------------------------------------------------------
+static uint64_t elapsed_us (struct timespec *ts)
+{
+    struct timespec now;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - ts->tv_sec) * 1000000ULL + (now.tv_nsec - ts->tv_nsec) / 1000;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+int session_record_open (const char *fname)
+{
+    session_hdr_t hdr = { SESSION_MAGIC, SESSION_VERSION, 0 };
+
+    if ((RecFp = fopen (fname, "wb")) == NULL) {
+        printf ("%s : %s open error!\n", __func__, fname);
+        return 0;
+    }
+    fwrite (&hdr, sizeof(hdr), 1, RecFp);
+    fflush (RecFp);
+    clock_gettime (CLOCK_MONOTONIC, &RecLast);
+
+    printf ("%s : record to %s\n", __func__, fname);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+void session_record (char dir, const void *data, int size)
+{
+    session_rec_t rec;
+    struct timespec now;
+
+    if ((RecFp == NULL) || (size <= 0))     return;
+
+    pthread_mutex_lock (&RecMutex);
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    rec.delta_us = (now.tv_sec - RecLast.tv_sec) * 1000000 + (now.tv_nsec - RecLast.tv_nsec) / 1000;
+    rec.dir      = dir;
+    rec.size     = (size > 255) ? 255 : size;
+    RecLast      = now;
+
+    fwrite (&rec, sizeof(rec), 1, RecFp);
+    fwrite (data, rec.size,    1, RecFp);
+    /* 비정상 종료시에도 trace 유지 */
+    fflush (RecFp);
+    pthread_mutex_unlock (&RecMutex);
+}
+
+//------------------------------------------------------------------------------
+void session_record_close (void)
+{
+    pthread_mutex_lock (&RecMutex);
+    if (RecFp != NULL)  fclose (RecFp);
+    RecFp = NULL;
+    pthread_mutex_unlock (&RecMutex);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// 전체 TX record 를 미리 읽어 둠. return : TX record 수
+//------------------------------------------------------------------------------
+static int session_replay_load_tx (void)
+{
+    session_rec_t rec;
+    session_tx_t *tx;
+    long pos = ftell (Play.fp);
+
+    while (fread (&rec, sizeof(rec), 1, Play.fp) == 1) {
+        if (rec.dir != SESSION_TX) {
+            if (fseek (Play.fp, rec.size, SEEK_CUR) < 0)    break;
+            continue;
+        }
+        if ((tx = realloc (Play.tx, (Play.tx_cnt + 1) * sizeof(session_tx_t))) == NULL)
+            break;
+        Play.tx = tx;
+        tx = &Play.tx[Play.tx_cnt];
+        memset (tx, 0, sizeof(session_tx_t));
+        if (fread (tx->data, rec.size, 1, Play.fp) != 1)
+            break;
+        tx->size = rec.size;
+        Play.tx_cnt++;
+    }
+    fseek (Play.fp, pos, SEEK_SET);
+    return Play.tx_cnt;
+}
+
+//------------------------------------------------------------------------------
+int session_replay_open (const char *fname, int speed)
+{
+    session_hdr_t hdr;
+
+    free (Play.tx);
+    memset (&Play, 0, sizeof(Play));
+
+    if ((Play.fp = fopen (fname, "rb")) == NULL) {
+        printf ("%s : %s open error!\n", __func__, fname);
+        return 0;
+    }
+    if ((fread (&hdr, sizeof(hdr), 1, Play.fp) != 1) ||
+        memcmp (hdr.magic, SESSION_MAGIC, sizeof(hdr.magic)) ||
+        (hdr.version != SESSION_VERSION)) {
+        printf ("%s : %s is not a session trace!\n", __func__, fname);
+        fclose (Play.fp);   Play.fp = NULL;
+        return 0;
+    }
+    Play.speed = (speed < 0) ? 1 : speed;
+    session_replay_load_tx ();
+
+    if (Play.speed)
+        printf ("%s : replay %s, speed = x%d\n", __func__, fname, Play.speed);
+    else
+        printf ("%s : replay %s, speed = max\n", __func__, fname);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+int session_replay_active (void)
+{
+    return (Play.fp != NULL);
+}
+
+//------------------------------------------------------------------------------
+int session_replay_done (void)
+{
+    return Play.done && !Play.pending && (Play.pos >= Play.size);
+}
+
+//------------------------------------------------------------------------------
+// 다음 RX record 를 읽음 (TX record 는 skip)
+//------------------------------------------------------------------------------
+static int session_replay_next (void)
+{
+    session_rec_t rec;
+
+    while (fread (&rec, sizeof(rec), 1, Play.fp) == 1) {
+        if (fread (Play.buf, rec.size, 1, Play.fp) != 1)
+            break;
+
+        Play.due_us += rec.delta_us;
+        if (rec.dir != SESSION_RX)
+            continue;
+
+        Play.size    = rec.size;
+        Play.pos     = 0;
+        Play.pending = 1;
+        return 1;
+    }
+    Play.done = 1;
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// transport 대신 사용. return 1 : data, 0 : no data (다음 frame 시간 전)
+//------------------------------------------------------------------------------
+int session_replay_read (unsigned char *data)
+{
+    if (!Play.pending && (Play.pos >= Play.size)) {
+        if (Play.done || !session_replay_next ())
+            return 0;
+    }
+
+    if (Play.pending) {
+        /* 첫 frame 요청 시점을 기준으로 replay 시간 계산 */
+        if (!Play.started) {
+            clock_gettime (CLOCK_MONOTONIC, &Play.start);
+            Play.started = 1;
+        }
+
+        /* 기록된 시간 / speed 가 지나야 frame 전달 */
+        if (Play.speed && (elapsed_us (&Play.start) * Play.speed < Play.due_us))
+            return 0;
+
+        Play.pending = 0;
+        Play.frames++;
+    }
+
+    Play.bytes++;
+    *data = Play.buf[Play.pos++];
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// 기록된 TX frame 중 match 가 1 을 반환하는 첫번째 미사용 frame 을 frame 에 복사.
+// consume 인 경우 사용됨으로 표시 (같은 항목의 다음 검사는 다음 기록을 사용)
+// return 1 : 찾음, 0 : 없음
+//------------------------------------------------------------------------------
+int session_replay_tx (int (*match)(const char *frame, void *arg), void *arg,
+                        char *frame, int consume)
+{
+    int i, found = 0;
+
+    pthread_mutex_lock (&PlayTxMutex);
+    for (i = 0; i < Play.tx_cnt; i++) {
+        session_tx_t *tx = &Play.tx[i];
+
+        if (tx->used || !match (tx->data, arg))
+            continue;
+        memcpy (frame, tx->data, tx->size + 1);
+        tx->used = consume;
+        found = 1;
+        break;
+    }
+    pthread_mutex_unlock (&PlayTxMutex);
+    return found;
+}
+
+//------------------------------------------------------------------------------
+void session_replay_parse (long parse_ns)
+{
+    Play.parse_ns += parse_ns;
+    if (parse_ns > Play.parse_max_ns)   Play.parse_max_ns = parse_ns;
+}
+
+//------------------------------------------------------------------------------
+void session_replay_report (void)
+{
+    double sec = elapsed_us (&Play.start) / 1e6;
+
+    printf ("%s : %ld frames, %ld bytes, %.3f sec, %.0f frames/sec\n",
+            __func__, Play.frames, Play.bytes, sec, sec > 0 ? Play.frames / sec : 0);
+    printf ("%s : protocol_parse avg = %ld us, max = %ld us\n", __func__,
+            Play.frames ? Play.parse_ns / Play.frames / 1000 : 0, Play.parse_max_ns / 1000);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
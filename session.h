@@ -0,0 +1,47 @@
+//------------------------------------------------------------------------------
+/**
+ * @file session.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client protocol session record & replay.
+ * @version 0.1
+ * @date 2025-09-29
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef	__SESSION_H__
+#define	__SESSION_H__
+
+//------------------------------------------------------------------------------
+#define SESSION_MAGIC       "JIGS"
+#define SESSION_VERSION     1
+
+/* record direction */
+#define SESSION_RX          'R'
+#define SESSION_TX          'T'
+
+//------------------------------------------------------------------------------
+// function prototype define
+//------------------------------------------------------------------------------
+extern  int     session_record_open     (const char *fname);
+extern  void    session_record          (char dir, const void *data, int size);
+extern  void    session_record_close    (void);
+
+extern  int     session_replay_open     (const char *fname, int speed);
+extern  int     session_replay_active   (void);
+extern  int     session_replay_done     (void);
+extern  int     session_replay_read     (unsigned char *data);
+extern  int     session_replay_tx       (int (*match)(const char *frame, void *arg), void *arg,
+                                        char *frame, int consume);
+extern  void    session_replay_parse    (long parse_ns);
+extern  void    session_replay_report   (void);
+
+//------------------------------------------------------------------------------
+#endif	// #define	__SESSION_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
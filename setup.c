@@ -94,27 +94,22 @@ static int find_file_path (const char *fname, char *file_path)
 #endif
 
 //------------------------------------------------------------------------------
-const char *get_model_cmd = "cat /proc/device-tree/model && sync";
+#define MODEL_NODE  "/proc/device-tree/model"
 
 static int get_model_name (char *pname)
 {
-    FILE *fp;
-    char *ptr, cmd_line[STR_PATH_LENGTH];
+    char *ptr, model[STR_PATH_LENGTH];
 
-    if (access ("/proc/device-tree/model", F_OK) != 0)
+    if (access (MODEL_NODE, F_OK) != 0)
         return 0;
 
-    memset (cmd_line, 0, sizeof(cmd_line));
+    memset (model, 0, sizeof(model));
 
-    if ((fp = popen(get_model_cmd, "r")) != NULL) {
-        if (NULL != fgets (cmd_line, sizeof(cmd_line), fp)) {
-            if ((ptr = strstr (cmd_line, "ODROID-")) != NULL) {
-                strncpy (pname, ptr, strlen(ptr));
-                pclose(fp);
-                return 1;
-            }
+    if (sysfs_cache_read (MODEL_NODE, model, sizeof(model)) > 0) {
+        if ((ptr = strstr (model, "ODROID-")) != NULL) {
+            strncpy (pname, ptr, strlen(ptr));
+            return 1;
         }
-        pclose(fp);
     }
     return 0;
 }
@@ -138,6 +133,8 @@ static int client_config (client_t *p, const char *model)
         printf ("%s : %s file open error!\n", __func__, buf);
         return 0;
     }
+    // soft reset ('B') 시 변경 여부 확인
+    cfg_watch_add (buf);
 
     while (fgets(buf, sizeof(buf), pfd) != NULL) {
 
@@ -148,6 +145,31 @@ static int client_config (client_t *p, const char *model)
             continue;
         }
 
+        // ORDER, policy, abort on hard fail, stat file,
+        if (!strncmp (buf, "ORDER,", strlen("ORDER,"))) {
+            test_order_config (buf);
+            continue;
+        }
+
+        // RT, enable, priority, rx core,
+        if (!strncmp (buf, "RT,", strlen("RT,"))) {
+            rt_profile_config (buf);
+            continue;
+        }
+
+        // TRANSPORT, type(uart, tcp, unix), address,
+        if (!strncmp (buf, "TRANSPORT,", strlen("TRANSPORT,"))) {
+            char *item;
+            if (strtok (buf, ",") != NULL) {
+                if ((item = strtok (NULL, ",")) != NULL)
+                    p->tport.type = transport_type (item);
+
+                if ((item = strtok (NULL, ",\n")) != NULL)
+                    strncpy (p->tport.addr, item, sizeof(p->tport.addr) -1);
+            }
+            continue;
+        }
+
         if (strstr (buf, model) != NULL) {
             char *item;
             // MODEL-NAME(DeviceTree), tty port, tty baud, hdmi fb,
@@ -165,6 +187,89 @@ static int client_config (client_t *p, const char *model)
     return check_cfg;
 }
 
+//------------------------------------------------------------------------------
+// dev cfg 파일에서 grp 문자열로 시작하는 라인을 찾아 func 호출.
+// (lib_dev_check 에서 처리하지 않는 client 측 check engine 설정용)
+// return : 처리된 라인 수
+//------------------------------------------------------------------------------
+int client_dev_config (const char *dev_fname, const char *grp,
+                        void (*func)(char *line, void *arg), void *arg)
+{
+    FILE *pfd;
+    char buf[STR_PATH_LENGTH] = {0,};
+    int check_cfg = 0, cnt = 0;
+
+    if (!find_file_path (dev_fname, buf)) {
+        printf ("%s : %s file not found!\n", __func__, dev_fname);
+        return 0;
+    }
+
+    if ((pfd = fopen(buf, "r")) == NULL) {
+        printf ("%s : %s file open error!\n", __func__, buf);
+        return 0;
+    }
+
+    while (fgets(buf, sizeof(buf), pfd) != NULL) {
+
+        if (buf[0] == '#' || buf[0] == '\n')  continue;
+
+        if (!check_cfg) {
+            if (strstr(buf, "ODROID-DEVICE-CONFIG") != NULL)    check_cfg = 1;
+            continue;
+        }
+
+        if (!strncmp (buf, grp, strlen(grp)) && (buf[strlen(grp)] == ',')) {
+            func (buf, arg);    cnt++;
+        }
+    }
+    fclose (pfd);
+
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+// ui cfg 'B' 라인의 초기 문자열 (soft reset 시 item 문자열 복원)
+// B, ID, x, y, w, h, lw, scale, align, GroupID, str,
+//------------------------------------------------------------------------------
+static char UIStr[UI_STR_MAX][STR_NAME_LENGTH];
+
+static void client_ui_config (const char *ui_fname)
+{
+    FILE *pfd;
+    char buf[STR_PATH_LENGTH], *item;
+    int i, uid;
+
+    memset (UIStr, 0, sizeof(UIStr));
+    if ((pfd = fopen(ui_fname, "r")) == NULL) {
+        printf ("%s : %s file open error!\n", __func__, ui_fname);
+        return;
+    }
+
+    while (fgets(buf, sizeof(buf), pfd) != NULL) {
+        if ((buf[0] != 'B') || (strtok (buf, ",") == NULL))     continue;
+        if ((item = strtok (NULL, ",")) == NULL)                continue;
+        if (((uid = atoi (item)) < 0) || (uid >= UI_STR_MAX))   continue;
+
+        // x, y, w, h, lw, scale, align, GroupID
+        for (i = 0; i < 8; i++)
+            if ((item = strtok (NULL, ",")) == NULL)    break;
+        if ((item == NULL) || ((item = strtok (NULL, ",\r\n")) == NULL))
+            continue;
+
+        while (*item == ' ')    item++;
+        strncpy (UIStr[uid], item, STR_NAME_LENGTH -1);
+    }
+    fclose (pfd);
+}
+
+//------------------------------------------------------------------------------
+char *client_ui_str (int uid)
+{
+    if ((uid < 0) || (uid >= UI_STR_MAX) || !UIStr[uid][0])
+        return NULL;
+    return UIStr[uid];
+}
+
 //------------------------------------------------------------------------------
 int client_setup (client_t *p)
 {
@@ -187,6 +292,9 @@ int client_setup (client_t *p)
 
         p->uart_baud = DEFAULT_UART_BAUDRATE;
     }
+    // client.cfg RT : lib_fbui, lib_dev_check 에서 생성하는 thread 가 rx core 를 사용하지 않도록
+    // main thread 를 먼저 worker core 로 제한. (main 은 rt_profile_rx 에서 rx core 로 변경)
+    rt_profile_worker ();
 
 printf("%s : p->uard_dev = %s, p->uard_baud = %d\n", __func__, p->uart_dev, p->uart_baud);
 
@@ -195,6 +303,10 @@ printf("%s : p->uard_dev = %s, p->uard_baud = %d\n", __func__, p->uart_dev, p->u
     // lib_dev_check.h???
     find_file_path (ui_fname, fname);
     if ((p->pui = ui_init (p->pfb, fname)) == NULL) exit(1);
+    cfg_watch_add (fname);
+    client_ui_config (fname);
+    // ui cfg 'D' : off-screen render & present mode
+    present_setup (p->pfb, fname);
     // Default Baudrate (115200 baud)
     if ((p->puart = uart_init (p->uart_dev, p->uart_baud)) != NULL) {
         if (ptc_grp_init (p->puart, 1)) {
@@ -203,12 +315,27 @@ printf("%s : p->uard_dev = %s, p->uard_baud = %d\n", __func__, p->uart_dev, p->u
                 exit(1);
             }
         }
-        // client device init (lib_dev_check)
-        if (!device_setup (dev_fname))  exit(1);
-
-        return 1;
     }
-    return 0;
+    // UART 가 없는 경우 socket transport 또는 session replay 시에만 계속 진행
+    if ((p->puart == NULL) && (p->tport.type == eTRANSPORT_UART) && !session_replay_active ())
+        return 0;
+
+    transport_init (&p->tport, p->puart);
+
+    // client device init (lib_dev_check)
+    if (!device_setup (dev_fname))  exit(1);
+    memset (fname, 0, sizeof(fname));
+    if (find_file_path (dev_fname, fname))
+        cfg_watch_add (fname);
+
+    // client check engine init
+    sysfs_cache_setup (dev_fname);
+    adc_sample_setup  (dev_fname);
+    led_check_setup   (dev_fname);
+    ir_event_setup    (dev_fname);
+    mem_test_setup    (dev_fname);
+
+    return 1;
 }
 
 //------------------------------------------------------------------------------
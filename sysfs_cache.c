@@ -0,0 +1,230 @@
+//------------------------------------------------------------------------------
+/**
+ * @file sysfs_cache.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client sysfs/procfs attribute handle cache.
+ * @version 0.1
+ * @date 2025-09-17
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <fcntl.h>
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+#include "client.h"
+#include "sysfs_cache.h"
+
+//------------------------------------------------------------------------------
+//
+// dev cfg 에 설정된 sysfs/procfs node 를 device_setup() 시점에 한번만 open 하고
+// 이후 read/write 는 pread/pwrite (offset 0) 로 처리함.
+// (open/read/close 또는 popen("cat ...") 의 반복 제거)
+//
+// lib_dev_check 내부의 read (HDMI, ETHERNET, fb 등) 는 submodule 에서 처리하므로
+// cache 는 client 쪽 경로 (ADC sampling, LED brightness/trigger, model) 에만 사용됨.
+//
+//------------------------------------------------------------------------------
+typedef struct sysfs_node__t {
+    int     fd;
+    char    node [STR_PATH_LENGTH];
+}   sysfs_node_t;
+
+static sysfs_node_t NODE[SYSFS_CACHE_MAX];
+static volatile int NodeCount = 0;
+
+static pthread_mutex_t NodeMutex = PTHREAD_MUTEX_INITIALIZER;
+
+//------------------------------------------------------------------------------
+static sysfs_node_t *sysfs_find (const char *node)
+{
+    int i;
+
+    for (i = 0; i < NodeCount; i++) {
+        if (!strcmp (NODE[i].node, node))
+            return &NODE[i];
+    }
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+// 등록되지 않은 node 의 경우 open 하여 cache 에 추가함.
+//------------------------------------------------------------------------------
+static sysfs_node_t *sysfs_get (const char *node)
+{
+    sysfs_node_t *pn;
+    int fd;
+
+    if ((pn = sysfs_find (node)) != NULL)
+        return pn;
+
+    pthread_mutex_lock (&NodeMutex);
+    if ((pn = sysfs_find (node)) != NULL)
+        goto out;
+
+    if (NodeCount >= SYSFS_CACHE_MAX) {
+        printf ("%s : cache full! (%s)\n", __func__, node);
+        goto out;
+    }
+
+    if ((fd = open (node, O_RDWR)) < 0) {
+        if ((fd = open (node, O_RDONLY)) < 0) {
+            printf ("%s : %s open error!\n", __func__, node);
+            goto out;
+        }
+    }
+
+    pn = &NODE[NodeCount];
+    memset (pn, 0, sizeof(sysfs_node_t));
+    strncpy (pn->node, node, sizeof(pn->node) -1);
+    pn->fd     = fd;
+
+    /* node 정보가 채워진 후 count 증가 (lock 없이 find 가능) */
+    __sync_synchronize ();
+    NodeCount++;
+out:
+    pthread_mutex_unlock (&NodeMutex);
+    return pn;
+}
+
+//------------------------------------------------------------------------------
+int sysfs_cache_open (const char *node)
+{
+    sysfs_node_t *pn = sysfs_get (node);
+
+    return pn ? pn->fd : -1;
+}
+
+//------------------------------------------------------------------------------
+// return : read size, -1 : error
+//------------------------------------------------------------------------------
+int sysfs_cache_read (const char *node, char *buf, int size)
+{
+    sysfs_node_t *pn;
+    int len;
+
+    if ((pn = sysfs_get (node)) == NULL)
+        return -1;
+
+    if ((len = pread (pn->fd, buf, size -1, 0)) < 0)
+        return -1;
+
+    buf[len] = 0;
+    return len;
+}
+
+//------------------------------------------------------------------------------
+int sysfs_cache_write (const char *node, const char *str)
+{
+    sysfs_node_t *pn;
+
+    if ((pn = sysfs_get (node)) == NULL)
+        return -1;
+
+    return pwrite (pn->fd, str, strlen(str), 0);
+}
+
+//------------------------------------------------------------------------------
+static void sysfs_config (char *line, void *arg)
+{
+    char *item;
+
+    (void)arg;
+    /* 설정 라인의 sysfs/procfs 경로만 등록 (/dev node 제외) */
+    for (item = strtok (line, ", \n"); item != NULL; item = strtok (NULL, ", \n")) {
+        if (!strncmp (item, "/sys/", 5) || !strncmp (item, "/proc/", 6))
+            sysfs_get (item);
+    }
+}
+
+//------------------------------------------------------------------------------
+int sysfs_cache_setup (const char *dev_fname)
+{
+    const char *grp[] = { "ADC", "LED", NULL };
+    int i;
+
+    for (i = 0; grp[i] != NULL; i++)
+        client_dev_config (dev_fname, grp[i], sysfs_config, NULL);
+
+    printf ("%s : %d node cached.\n", __func__, NodeCount);
+    return NodeCount;
+}
+
+//------------------------------------------------------------------------------
+void sysfs_cache_close (void)
+{
+    int i;
+
+    pthread_mutex_lock (&NodeMutex);
+    for (i = 0; i < NodeCount; i++)
+        close (NODE[i].fd);
+    NodeCount = 0;
+    pthread_mutex_unlock (&NodeMutex);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static double bench_time (struct timespec *ts)
+{
+    struct timespec te;
+
+    clock_gettime (CLOCK_MONOTONIC, &te);
+    return (te.tv_sec - ts->tv_sec) + (te.tv_nsec - ts->tv_nsec) / 1e9;
+}
+
+//------------------------------------------------------------------------------
+// 기존 read 경로 (popen, open/read/close) 와 cache(pread) 의 reads/sec 비교
+//------------------------------------------------------------------------------
+void sysfs_cache_bench (const char *node, int loops)
+{
+    struct timespec ts;
+    char buf[SYSFS_VALUE_SIZE], cmd[STR_PATH_LENGTH + 16];
+    double sec;
+    int i, fd, p_loops = (loops / 100) ? (loops / 100) : 1;
+    FILE *fp;
+
+    if (sysfs_cache_read (node, buf, sizeof(buf)) < 0)
+        return;
+
+    printf ("%s : node = %s, value = %s\n", __func__, node, buf);
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    for (i = 0; i < p_loops; i++) {
+        sprintf (cmd, "cat %s", node);
+        if ((fp = popen (cmd, "r")) != NULL) {
+            if (fgets (buf, sizeof(buf), fp) == NULL)   buf[0] = 0;
+            pclose (fp);
+        }
+    }
+    sec = bench_time (&ts);
+    printf ("%s : popen             %10.0f reads/sec\n", __func__, p_loops / sec);
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    for (i = 0; i < loops; i++) {
+        if ((fd = open (node, O_RDONLY)) >= 0) {
+            if (read (fd, buf, sizeof(buf) -1) < 0)     buf[0] = 0;
+            close (fd);
+        }
+    }
+    sec = bench_time (&ts);
+    printf ("%s : open/read/close   %10.0f reads/sec\n", __func__, loops / sec);
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    for (i = 0; i < loops; i++)
+        sysfs_cache_read (node, buf, sizeof(buf));
+    sec = bench_time (&ts);
+    printf ("%s : sysfs_cache_read  %10.0f reads/sec\n", __func__, loops / sec);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,39 @@
+//------------------------------------------------------------------------------
+/**
+ * @file sysfs_cache.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client sysfs/procfs attribute handle cache.
+ * @version 0.1
+ * @date 2025-09-17
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef	__SYSFS_CACHE_H__
+#define	__SYSFS_CACHE_H__
+
+//------------------------------------------------------------------------------
+#define SYSFS_CACHE_MAX     48
+#define SYSFS_VALUE_SIZE    64
+
+#define SYSFS_BENCH_LOOPS   10000
+
+//------------------------------------------------------------------------------
+// function prototype define
+//------------------------------------------------------------------------------
+extern  int     sysfs_cache_open    (const char *node);
+extern  int     sysfs_cache_read    (const char *node, char *buf, int size);
+extern  int     sysfs_cache_write   (const char *node, const char *str);
+extern  int     sysfs_cache_setup   (const char *dev_fname);
+extern  void    sysfs_cache_close   (void);
+extern  void    sysfs_cache_bench   (const char *node, int loops);
+
+//------------------------------------------------------------------------------
+#endif	// #define	__SYSFS_CACHE_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+/**
+ * @file test_adc_sample.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client adc_sample test (fake sysfs node).
+ * @version 0.1
+ * @date 2025-10-14
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+/* static 함수(adc_calc) 확인을 위해 source 를 직접 include 함 */
+#include "../adc_sample.c"
+#include "test_common.h"
+
+//------------------------------------------------------------------------------
+//
+// ADC_CH 의 iio node 를 임시 파일로 대체하여 outlier 제거 및 pass/fail 판정 확인.
+//
+//------------------------------------------------------------------------------
+static char TmpDir[] = "/tmp/adc_testXXXXXX";
+
+//------------------------------------------------------------------------------
+// ADC,did,<tmp>/in_voltageN_input,max,min, + node 값 기록
+//------------------------------------------------------------------------------
+static void fake_adc (int did, int value, int max, int min)
+{
+    char node[STR_PATH_LENGTH / 2];
+    FILE *fp;
+
+    snprintf (node, sizeof(node), "%s/in_voltage%d_input", TmpDir, did);
+    if ((fp = fopen (node, "w")) != NULL) {
+        fprintf (fp, "%d\n", value);
+        fclose (fp);
+    }
+    test_dev_line ("ADC,%d,%s,%d,%d,", did, node, max, min);
+}
+
+//------------------------------------------------------------------------------
+static void test_outlier (void)
+{
+    int smp[16], i;
+    adc_stat_t stat;
+    double hw2;
+
+    /* 1350 +- 2 noise, spike 2 개 (4095, 0) */
+    for (i = 0; i < 16; i++)
+        smp[i] = 1348 + (i % 5);
+    smp[3] = 4095;  smp[11] = 0;
+
+    memset (&stat, 0, sizeof(stat));
+    adc_calc (smp, 16, &stat, &hw2);
+
+    printf ("%s : value = %d, median = %d, rejected = %d\n",
+            __func__, stat.value, stat.median, stat.rejected);
+    TEST_CHECK (stat.rejected == 2);
+    TEST_CHECK ((stat.value >= 1348) && (stat.value <= 1352));
+    TEST_CHECK (hw2 < 4.0);
+}
+
+//------------------------------------------------------------------------------
+static void test_decision (void)
+{
+    char resp[SERIAL_RESP_SIZE];
+    adc_stat_t stat;
+
+    /* did 0 : 범위 안, did 1 : 범위 밖, did 2 : 없는 node */
+    fake_adc (0, 1350, 1400, 1300);
+    fake_adc (1, 1500, 1400, 1300);
+    test_dev_line ("ADC,2,%s/none,1400,1300,", TmpDir);
+
+    TEST_CHECK (adc_sample_setup ("fake_dev.cfg") == 3);
+
+    TEST_CHECK (adc_sample_check (0, resp) == 1);
+    TEST_CHECK (adc_sample_stat (0, &stat) && (stat.value == 1350));
+    /* 일정한 값은 최소 sample 수에서 판정 */
+    TEST_CHECK (stat.samples == ADC_SAMPLE_MIN);
+    TEST_CHECK (resp[0] == 'P');
+
+    TEST_CHECK (adc_sample_check (1, resp) == 0);
+    TEST_CHECK (resp[0] == 'F');
+
+    /* open 되지 않은 channel 은 lib_dev_check 로 처리 */
+    TEST_CHECK (adc_sample_check (2, resp) == -1);
+    TEST_CHECK (adc_sample_check (ADC_CH_MAX, resp) == -1);
+}
+
+//------------------------------------------------------------------------------
+int main (void)
+{
+    char cmd[STR_PATH_LENGTH];
+
+    if (mkdtemp (TmpDir) == NULL) {
+        printf ("%s : mkdtemp error!\n", __func__);
+        return 1;
+    }
+
+    test_outlier  ();
+    test_decision ();
+
+    sysfs_cache_close ();
+    snprintf (cmd, sizeof(cmd), "rm -rf %s", TmpDir);
+    if (system (cmd))   printf ("%s : %s remove error!\n", __func__, TmpDir);
+
+    return test_result (__FILE__);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------------
+/**
+ * @file test_common.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client unit test common (check macro, fake dev cfg).
+ * @version 0.1
+ * @date 2025-10-14
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef	__TEST_COMMON_H__
+#define	__TEST_COMMON_H__
+
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+#include "client.h"
+
+//------------------------------------------------------------------------------
+//
+// 각 test 는 이 파일을 한번만 include 함. (test 실행 파일 당 1개)
+// dev cfg 파일 대신 test_dev_line() 으로 등록한 라인을 client_dev_config 에서 전달함.
+//
+//------------------------------------------------------------------------------
+#define TEST_DEV_LINE_MAX   16
+
+static int Fails = 0;
+
+#define TEST_CHECK(cond)    do {                                            \
+    if (!(cond)) { printf ("%s:%d : FAIL (%s)\n", __func__, __LINE__, #cond); Fails++; } \
+} while (0)
+
+static char TestDevLine[TEST_DEV_LINE_MAX][STR_PATH_LENGTH];
+static int  TestDevLineCnt = 0;
+
+//------------------------------------------------------------------------------
+static inline void test_dev_line (const char *fmt, ...)
+{
+    va_list va;
+
+    if (TestDevLineCnt >= TEST_DEV_LINE_MAX)    return;
+
+    va_start (va, fmt);
+    vsnprintf (TestDevLine[TestDevLineCnt++], STR_PATH_LENGTH, fmt, va);
+    va_end (va);
+}
+
+//------------------------------------------------------------------------------
+int client_dev_config (const char *dev_fname, const char *grp,
+                        void (*func)(char *line, void *arg), void *arg)
+{
+    char buf[STR_PATH_LENGTH];
+    int i, cnt = 0;
+
+    (void)dev_fname;
+    for (i = 0; i < TestDevLineCnt; i++) {
+        if (strncmp (TestDevLine[i], grp, strlen(grp)) || (TestDevLine[i][strlen(grp)] != ','))
+            continue;
+        strncpy (buf, TestDevLine[i], sizeof(buf) -1);  buf[sizeof(buf) -1] = 0;
+        func (buf, arg);    cnt++;
+    }
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+static inline int test_result (const char *fname)
+{
+    printf ("%s : %s\n", fname, Fails ? "FAIL" : "PASS");
+    return Fails ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+#endif	// #define	__TEST_COMMON_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------------
+/**
+ * @file test_ir_event.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client ir_event end-to-end test (uinput).
+ * @version 0.1
+ * @date 2025-10-14
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <linux/uinput.h>
+
+//------------------------------------------------------------------------------
+#include "test_common.h"
+
+//------------------------------------------------------------------------------
+//
+// key event 를 주입하여 ir_event (epoll thread) 의 count, pass 판정, 완료 통지(wait),
+// reset 을 확인함. uinput 으로 가상 IR device 를 만들어 evdev 경로를 확인하고,
+// /dev/uinput 이 없거나 권한이 없는 경우 fifo 를 event node 로 설정하여
+// input_event 를 직접 write 함.
+//
+//------------------------------------------------------------------------------
+#define TEST_IR_NAME        "jig-test-ir"
+#define TEST_IR_KEY         KEY_OK
+#define TEST_IR_COUNT       3
+
+/* 마지막 key 주입 지연, key 주입부터 ir_event_wait 반환까지 허용 시간 */
+#define TEST_KEY_DELAY_MS   100
+#define TEST_WAIT_MAX_MS    50
+
+static char FifoPath[STR_PATH_LENGTH / 2] = "/tmp/ir_testXXXXXX";
+static int  KeyFd = -1;
+
+//------------------------------------------------------------------------------
+static void key_emit (int fd, int type, int code, int value)
+{
+    struct input_event ev;
+
+    memset (&ev, 0, sizeof(ev));
+    ev.type = type;     ev.code = code;     ev.value = value;
+    if (write (fd, &ev, sizeof(ev)) != sizeof(ev))
+        printf ("%s : write error!\n", __func__);
+}
+
+//------------------------------------------------------------------------------
+static void key_press (int fd, int code)
+{
+    key_emit (fd, EV_KEY, code, 1);  key_emit (fd, EV_SYN, SYN_REPORT, 0);
+    key_emit (fd, EV_KEY, code, 0);  key_emit (fd, EV_SYN, SYN_REPORT, 0);
+    usleep (20 * 1000);
+}
+
+//------------------------------------------------------------------------------
+static int fifo_open (void)
+{
+    int fd;
+
+    if (mkdtemp (FifoPath) == NULL)     return -1;
+    strncat (FifoPath, "/event", sizeof(FifoPath) - strlen(FifoPath) -1);
+    if (mkfifo (FifoPath, 0600) < 0)    return -1;
+
+    /* reader(ir_event) 가 open 되기 전에 write 쪽을 유지하기 위해 O_RDWR 사용 */
+    if ((fd = open (FifoPath, O_RDWR | O_NONBLOCK)) < 0)
+        return -1;
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+static int uinput_open (void)
+{
+    struct uinput_setup us;
+    int fd;
+
+    if ((fd = open ("/dev/uinput", O_WRONLY | O_NONBLOCK)) < 0)
+        return -1;
+
+    ioctl (fd, UI_SET_EVBIT, EV_KEY);
+    ioctl (fd, UI_SET_KEYBIT, TEST_IR_KEY);
+    ioctl (fd, UI_SET_KEYBIT, KEY_UP);
+
+    memset (&us, 0, sizeof(us));
+    us.id.bustype = BUS_VIRTUAL;
+    strncpy (us.name, TEST_IR_NAME, UINPUT_MAX_NAME_SIZE -1);
+
+    if ((ioctl (fd, UI_DEV_SETUP, &us) < 0) || (ioctl (fd, UI_DEV_CREATE) < 0)) {
+        close (fd);
+        return -1;
+    }
+    /* udev 에서 event node 생성 대기 */
+    sleep (1);
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+// ir_event_wait 대기중에 마지막 key 주입
+//------------------------------------------------------------------------------
+static void *key_thread (void *arg)
+{
+    usleep (TEST_KEY_DELAY_MS * 1000);
+    key_press (KeyFd, TEST_IR_KEY);
+    return arg;
+}
+
+//------------------------------------------------------------------------------
+int main (void)
+{
+    char resp[SERIAL_RESP_SIZE];
+    struct timespec ts, te;
+    pthread_t th;
+    long ms;
+    int fd, i, uinput;
+
+    // IR,-1,event find str,pass_count,pass_key_code,
+    if ((uinput = ((fd = uinput_open ()) >= 0))) {
+        test_dev_line ("IR,-1,%s,%d,%d,", TEST_IR_NAME, TEST_IR_COUNT, TEST_IR_KEY);
+    } else {
+        if ((fd = fifo_open ()) < 0) {
+            printf ("%s : fifo error!\n", __FILE__);
+            return 1;
+        }
+        test_dev_line ("IR,-1,%s,%d,%d,", FifoPath, TEST_IR_COUNT, TEST_IR_KEY);
+    }
+    printf ("%s : %s event source\n", __FILE__, uinput ? "uinput" : "fifo");
+    TEST_CHECK (ir_event_setup ("fake_dev.cfg") == 1);
+
+    /* pass key 가 아닌 event 는 count 하지 않음 */
+    key_press (fd, KEY_UP);
+    for (i = 0; i < TEST_IR_COUNT -1; i++)
+        key_press (fd, TEST_IR_KEY);
+    TEST_CHECK (ir_event_wait (200) == 0);
+    TEST_CHECK (ir_event_check (resp) == 0);
+    TEST_CHECK (resp[0] == 'F');
+
+    /* 대기중인 ir_event_wait 는 마지막 event 에서 바로 반환 (polling 없음) */
+    KeyFd = fd;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    pthread_create (&th, NULL, key_thread, NULL);
+    TEST_CHECK (ir_event_wait (1000) == 1);
+    clock_gettime (CLOCK_MONOTONIC, &te);
+    pthread_join (th, NULL);
+
+    ms = (te.tv_sec - ts.tv_sec) * 1000 + (te.tv_nsec - ts.tv_nsec) / 1000000;
+    printf ("%s : ir_event_wait returned after %ld ms\n", __func__, ms);
+    TEST_CHECK ((ms >= TEST_KEY_DELAY_MS) && (ms < TEST_KEY_DELAY_MS + TEST_WAIT_MAX_MS));
+
+    /* 결과 문자열 : count/pass_count 이벤트 간 평균 간격 */
+    TEST_CHECK (ir_event_check (resp) == 1);
+    TEST_CHECK (resp[0] == 'P');
+    TEST_CHECK (strstr (resp, "3/3 ") != NULL);
+
+    /* reset 후에는 새로 들어온 event 만 count */
+    ir_event_reset ();
+    TEST_CHECK (ir_event_ready () == 0);
+    for (i = 0; i < TEST_IR_COUNT; i++)
+        key_press (fd, TEST_IR_KEY);
+    TEST_CHECK (ir_event_wait (1000) == 1);
+
+    if (uinput) {
+        ioctl (fd, UI_DEV_DESTROY);
+        close (fd);
+    } else {
+        close (fd);
+        unlink (FifoPath);
+        *strrchr (FifoPath, '/') = 0;
+        rmdir (FifoPath);
+    }
+
+    return test_result (__FILE__);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+/**
+ * @file test_session.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client session record & replay test (round-trip).
+ * @version 0.1
+ * @date 2025-10-14
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+//------------------------------------------------------------------------------
+#include "test_common.h"
+
+//------------------------------------------------------------------------------
+//
+// 임시 파일에 RX/TX frame 을 기록(-w)한 후 replay(-r) 하여
+// RX frame 순서/내용, TX frame 제외, 기록된 TX 결과 조회(session_replay_tx),
+// 실시간(speed 1) 지연, 잘못된 파일 거부를 확인함.
+//
+//------------------------------------------------------------------------------
+#define TEST_RX_B           "@B,00,00,0,                   0#"
+#define TEST_RX_R           "@R,08,01,0,                   0#"
+#define TEST_TX_S1          "@S,08,01,C,              P1_6.7#"
+#define TEST_TX_S2          "@S,08,01,P,              P1_6.7#"
+#define TEST_TX_M           "@M,00,00,0,                   0#"
+
+/* RX_B 와 RX_R 사이의 기록 간격 */
+#define TEST_GAP_MS         100
+
+static char SessionFile[STR_PATH_LENGTH];
+
+//------------------------------------------------------------------------------
+static long elapsed_ms (struct timespec *ts)
+{
+    struct timespec now;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - ts->tv_sec) * 1000 + (now.tv_nsec - ts->tv_nsec) / 1000000;
+}
+
+//------------------------------------------------------------------------------
+static void record_session (void)
+{
+    TEST_CHECK (session_record_open (SessionFile) == 1);
+
+    session_record (SESSION_RX, TEST_RX_B,  strlen(TEST_RX_B));
+    session_record (SESSION_TX, TEST_TX_M,  strlen(TEST_TX_M));
+    session_record (SESSION_TX, "\r\n",     2);
+    session_record (SESSION_TX, TEST_TX_S1, strlen(TEST_TX_S1));
+    session_record (SESSION_TX, "\r\n",     2);
+    usleep (TEST_GAP_MS * 1000);
+    session_record (SESSION_RX, TEST_RX_R,  strlen(TEST_RX_R));
+    session_record (SESSION_TX, TEST_TX_S2, strlen(TEST_TX_S2));
+    session_record (SESSION_TX, "\r\n",     2);
+
+    session_record_close ();
+}
+
+//------------------------------------------------------------------------------
+// replay 된 RX data 를 size 만큼 읽음. (speed 0 : 대기 없음)
+//------------------------------------------------------------------------------
+static int replay_frame (char *buf, int size)
+{
+    unsigned char c;
+    int cnt = 0;
+
+    while ((cnt < size) && session_replay_read (&c))
+        buf[cnt++] = c;
+    buf[cnt] = 0;
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+static int match_sgid (const char *frame, void *arg)
+{
+    return !strncmp (frame, (const char *)arg, strlen((const char *)arg));
+}
+
+//------------------------------------------------------------------------------
+static void test_round_trip (void)
+{
+    char buf[STR_PATH_LENGTH];
+
+    TEST_CHECK (session_replay_open (SessionFile, 0) == 1);
+    TEST_CHECK (session_replay_active ());
+
+    // RX frame 만 기록된 순서대로 전달
+    TEST_CHECK (replay_frame (buf, strlen(TEST_RX_B)) == (int)strlen(TEST_RX_B));
+    TEST_CHECK (!strcmp (buf, TEST_RX_B));
+    TEST_CHECK (!session_replay_done ());
+    TEST_CHECK (replay_frame (buf, strlen(TEST_RX_R)) == (int)strlen(TEST_RX_R));
+    TEST_CHECK (!strcmp (buf, TEST_RX_R));
+    TEST_CHECK (replay_frame (buf, 1) == 0);
+    TEST_CHECK (session_replay_done ());
+
+    // 기록된 TX 결과 : consume = 0 은 확인만, consume = 1 은 다음 기록으로 진행
+    memset (buf, 0, sizeof(buf));
+    TEST_CHECK (session_replay_tx (match_sgid, "@S,08,01,", buf, 0) == 1);
+    TEST_CHECK (!strcmp (buf, TEST_TX_S1));
+    TEST_CHECK (session_replay_tx (match_sgid, "@S,08,01,", buf, 1) == 1);
+    TEST_CHECK (!strcmp (buf, TEST_TX_S1));
+    TEST_CHECK (session_replay_tx (match_sgid, "@S,08,01,", buf, 1) == 1);
+    TEST_CHECK (!strcmp (buf, TEST_TX_S2));
+    TEST_CHECK (session_replay_tx (match_sgid, "@S,08,01,", buf, 1) == 0);
+    TEST_CHECK (session_replay_tx (match_sgid, "@S,09,01,", buf, 1) == 0);
+    TEST_CHECK (session_replay_tx (match_sgid, "@M,",       buf, 1) == 1);
+    TEST_CHECK (!strcmp (buf, TEST_TX_M));
+
+    // 다시 open 하면 TX 기록도 처음부터 사용
+    TEST_CHECK (session_replay_open (SessionFile, 0) == 1);
+    TEST_CHECK (session_replay_tx (match_sgid, "@S,08,01,", buf, 1) == 1);
+    TEST_CHECK (!strcmp (buf, TEST_TX_S1));
+}
+
+//------------------------------------------------------------------------------
+static void test_realtime (void)
+{
+    struct timespec ts;
+    unsigned char c;
+    int cnt;
+    long ms;
+
+    TEST_CHECK (session_replay_open (SessionFile, 1) == 1);
+
+    // 첫 frame 요청 시점 기준으로 기록된 간격 후에 두번째 frame 전달
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    for (cnt = 0; cnt < (int)strlen(TEST_RX_B) && (elapsed_ms (&ts) < TEST_GAP_MS); ) {
+        if (session_replay_read (&c))   cnt++;
+        else                            usleep (1000);
+    }
+    TEST_CHECK (cnt == (int)strlen(TEST_RX_B));
+    TEST_CHECK (session_replay_read (&c) == 0);
+
+    while (!session_replay_read (&c) && (elapsed_ms (&ts) < TEST_GAP_MS * 3))
+        usleep (1000);
+    ms = elapsed_ms (&ts);
+    TEST_CHECK (c == TEST_RX_R[0]);
+    TEST_CHECK ((ms >= TEST_GAP_MS * 8 / 10) && (ms < TEST_GAP_MS * 2));
+}
+
+//------------------------------------------------------------------------------
+static void test_bad_file (void)
+{
+    FILE *fp;
+
+    TEST_CHECK ((fp = fopen (SessionFile, "wb")) != NULL);
+    if (fp) {
+        fputs ("JIGX not a session", fp);
+        fclose (fp);
+    }
+    TEST_CHECK (session_replay_open (SessionFile, 0) == 0);
+    TEST_CHECK (!session_replay_active ());
+    TEST_CHECK (session_replay_open ("/nonexistent/session.jig", 0) == 0);
+}
+
+//------------------------------------------------------------------------------
+int main (void)
+{
+    int fd;
+
+    strcpy (SessionFile, "/tmp/test_session.XXXXXX");
+    if ((fd = mkstemp (SessionFile)) < 0) {
+        printf ("%s : temp file error!\n", __FILE__);
+        return 1;
+    }
+    close (fd);
+
+    record_session  ();
+    test_round_trip ();
+    test_realtime   ();
+    test_bad_file   ();
+
+    unlink (SessionFile);
+    return test_result (__FILE__);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
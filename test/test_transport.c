@@ -0,0 +1,328 @@
+//------------------------------------------------------------------------------
+/**
+ * @file test_transport.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client transport test (loopback stand-in server).
+ * @version 0.1
+ * @date 2025-10-14
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+//------------------------------------------------------------------------------
+#include "test_common.h"
+
+//------------------------------------------------------------------------------
+//
+// unix socket / tcp(127.0.0.1) 로 server 를 대신하는 loopback server 를 만들어
+// 연결, 송수신, 끊어짐(uart fallback), non-blocking 재연결, send buffer full(EAGAIN),
+// 나누어 수신된 '@' ~ '#' frame 처리를 확인함. (UART 없음)
+//
+//------------------------------------------------------------------------------
+#define TEST_FRAME          "@S,08,01,C,              P1_6.7#\r\n"
+
+/* transport_read 1회 호출의 최대 허용 시간 (RX loop 를 막지 않음) */
+#define TEST_READ_MAX_MS    5
+
+//------------------------------------------------------------------------------
+static long elapsed_ms (struct timespec *ts)
+{
+    struct timespec now;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - ts->tv_sec) * 1000 + (now.tv_nsec - ts->tv_nsec) / 1000000;
+}
+
+//------------------------------------------------------------------------------
+static int server_unix (const char *path)
+{
+    struct sockaddr_un su;
+    int fd;
+
+    if ((fd = socket (AF_UNIX, SOCK_STREAM, 0)) < 0)    return -1;
+
+    memset (&su, 0, sizeof(su));
+    su.sun_family = AF_UNIX;
+    snprintf (su.sun_path, sizeof(su.sun_path), "%s", path);
+    unlink (path);
+    if ((bind (fd, (struct sockaddr *)&su, sizeof(su)) < 0) || (listen (fd, 1) < 0)) {
+        close (fd);
+        return -1;
+    }
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+// port 가 0 인 경우 빈 port 를 할당하고 *port 에 저장
+//------------------------------------------------------------------------------
+static int server_tcp (int *port)
+{
+    struct sockaddr_in si;
+    socklen_t len = sizeof(si);
+    int fd, on = 1;
+
+    if ((fd = socket (AF_INET, SOCK_STREAM, 0)) < 0)    return -1;
+    setsockopt (fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    memset (&si, 0, sizeof(si));
+    si.sin_family      = AF_INET;
+    si.sin_port        = htons (*port);
+    si.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+    if ((bind (fd, (struct sockaddr *)&si, sizeof(si)) < 0) || (listen (fd, 1) < 0) ||
+        (getsockname (fd, (struct sockaddr *)&si, &len) < 0)) {
+        close (fd);
+        return -1;
+    }
+    *port = ntohs (si.sin_port);
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+// data 가 없는 상태에서 transport_read 가 block 되지 않는지 확인하며 n 회 호출
+//------------------------------------------------------------------------------
+static int read_bytes (transport_t *pt, char *buf, int size, int loops)
+{
+    struct timespec ts;
+    unsigned char data;
+    int cnt = 0, rx;
+    long ms, max_ms = 0;
+
+    while ((cnt < size) && loops--) {
+        clock_gettime (CLOCK_MONOTONIC, &ts);
+        rx = transport_read (pt, &data);
+        /* transport_read 호출 시간만 측정 (usleep 제외) */
+        if ((ms = elapsed_ms (&ts)) > max_ms)   max_ms = ms;
+        if (rx)     buf[cnt++] = data;
+        else        usleep (1000);
+    }
+    TEST_CHECK (max_ms <= TEST_READ_MAX_MS);
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+static void test_frame (transport_t *pt, int sfd)
+{
+    char buf[64];
+    int cfd, len;
+
+    TEST_CHECK ((cfd = accept (sfd, NULL, NULL)) >= 0);
+
+    /* client -> server */
+    TEST_CHECK (transport_write (pt, TEST_FRAME, strlen(TEST_FRAME)) == (int)strlen(TEST_FRAME));
+    memset (buf, 0, sizeof(buf));
+    len = recv (cfd, buf, sizeof(buf) -1, 0);
+    TEST_CHECK ((len == (int)strlen(TEST_FRAME)) && !strcmp (buf, TEST_FRAME));
+
+    /* server -> client */
+    TEST_CHECK (send (cfd, TEST_FRAME, strlen(TEST_FRAME), 0) == (int)strlen(TEST_FRAME));
+    memset (buf, 0, sizeof(buf));
+    TEST_CHECK (read_bytes (pt, buf, strlen(TEST_FRAME), 1000) == (int)strlen(TEST_FRAME));
+    TEST_CHECK (!strcmp (buf, TEST_FRAME));
+
+    /* server 끊어짐 -> uart fallback (uart 없음 = 0) */
+    close (cfd);
+    read_bytes (pt, buf, 1, 100);
+    TEST_CHECK (pt->fd < 0);
+    TEST_CHECK (transport_write (pt, TEST_FRAME, strlen(TEST_FRAME)) == 0);
+}
+
+//------------------------------------------------------------------------------
+static void test_unix (void)
+{
+    char path[] = "/tmp/jig_test_sockXXXXXX";
+    transport_t tport;
+    int sfd, tfd;
+    char buf[4];
+
+    if ((tfd = mkstemp (path)) >= 0)    close (tfd);
+    TEST_CHECK ((sfd = server_unix (path)) >= 0);
+
+    memset (&tport, 0, sizeof(tport));
+    tport.type = eTRANSPORT_UNIX;
+    snprintf (tport.addr, sizeof(tport.addr), "%s", path);
+
+    TEST_CHECK (transport_init (&tport, NULL) == 1);
+    TEST_CHECK (tport.fd >= 0);
+    test_frame (&tport, sfd);
+
+    /* 재연결 (retry 간격 생략) */
+    tport.retry = 0;
+    read_bytes (&tport, buf, 1, 100);
+    TEST_CHECK (tport.fd >= 0);
+    if (tport.fd >= 0)
+        test_frame (&tport, sfd);
+
+    transport_close (&tport);
+    close (sfd);
+    unlink (path);
+}
+
+//------------------------------------------------------------------------------
+static void test_tcp (void)
+{
+    transport_t tport;
+    int sfd, cfd, port = 0, i, sent, total = 0;
+    char buf[4], *big;
+
+    /* 빈 port 확인 후 server 없이 시작 */
+    TEST_CHECK ((sfd = server_tcp (&port)) >= 0);
+    close (sfd);
+
+    memset (&tport, 0, sizeof(tport));
+    tport.type = eTRANSPORT_TCP;
+    snprintf (tport.addr, sizeof(tport.addr), "127.0.0.1:%d", port);
+
+    TEST_CHECK (transport_init (&tport, NULL) == 0);
+    TEST_CHECK (read_bytes (&tport, buf, 1, 10) == 0);
+
+    /* server 시작 후 재연결 */
+    TEST_CHECK ((sfd = server_tcp (&port)) >= 0);
+    tport.retry = 0;
+    read_bytes (&tport, buf, 1, 100);
+    TEST_CHECK (tport.fd >= 0);
+
+    /* server 가 read 하지 않는 경우 (send buffer full) 연결 유지 */
+    TEST_CHECK ((cfd = accept (sfd, NULL, NULL)) >= 0);
+    if ((big = malloc (64 * 1024)) != NULL) {
+        memset (big, 'x', 64 * 1024);
+        for (i = 0; i < 256; i++) {
+            if ((sent = transport_write (&tport, big, 64 * 1024)) < 64 * 1024)
+                break;
+            total += sent;
+        }
+        printf ("%s : send buffer full after %d KB\n", __func__, total / 1024);
+        TEST_CHECK (i < 256);
+        /* 일부만 송신된 경우 실패로 처리하고 연결을 끊음 (uart fallback) */
+        TEST_CHECK (sent < 64 * 1024);
+        TEST_CHECK (tport.fd < 0);
+        free (big);
+    }
+    close (cfd);
+
+    transport_close (&tport);
+    close (sfd);
+}
+
+//------------------------------------------------------------------------------
+// server -> client frame ('@' ~ '#', SERIAL_RESP_SIZE)
+//------------------------------------------------------------------------------
+static void make_frame (char *frame, char cmd)
+{
+    memset (frame, ' ', SERIAL_RESP_SIZE);
+    frame[0] = '@';     frame[2] = cmd;
+    frame[SERIAL_RESP_SIZE -1] = '#';
+    frame[SERIAL_RESP_SIZE]    = 0;
+}
+
+//------------------------------------------------------------------------------
+// protocol_msg_rx 를 반복 호출하여 frame 1개 수신. return 1 : 수신
+//------------------------------------------------------------------------------
+static int rx_frame (transport_t *pt, char *rx_msg, int loops)
+{
+    while (loops--) {
+        memset (rx_msg, 0, SERIAL_RESP_SIZE +1);
+        if (protocol_msg_rx (pt, rx_msg))
+            return 1;
+        usleep (1000);
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+static void send_part (int cfd, const char *data, int size)
+{
+    TEST_CHECK (send (cfd, data, size, 0) == size);
+    usleep (20 * 1000);
+}
+
+//------------------------------------------------------------------------------
+static void test_framing (void)
+{
+    char path[] = "/tmp/jig_test_sockXXXXXX";
+    char frame[SERIAL_RESP_SIZE +1], frame2[SERIAL_RESP_SIZE +1], rx_msg[SERIAL_RESP_SIZE +1];
+    char two[SERIAL_RESP_SIZE * 2];
+    transport_t tport;
+    int sfd, cfd, tfd;
+
+    if ((tfd = mkstemp (path)) >= 0)    close (tfd);
+    TEST_CHECK ((sfd = server_unix (path)) >= 0);
+
+    memset (&tport, 0, sizeof(tport));
+    tport.type = eTRANSPORT_UNIX;
+    snprintf (tport.addr, sizeof(tport.addr), "%s", path);
+    TEST_CHECK (transport_init (&tport, NULL) == 1);
+    TEST_CHECK ((cfd = accept (sfd, NULL, NULL)) >= 0);
+
+    make_frame (frame,  'O');
+    make_frame (frame2, 'C');
+
+    /* 잡음 + 3 개로 나누어 송신된 frame */
+    send_part (cfd, "#@x", 3);
+    TEST_CHECK (rx_frame (&tport, rx_msg, 10) == 0);
+    send_part (cfd, frame, 5);
+    TEST_CHECK (rx_frame (&tport, rx_msg, 10) == 0);
+    send_part (cfd, frame + 5, 10);
+    TEST_CHECK (rx_frame (&tport, rx_msg, 10) == 0);
+    send_part (cfd, frame + 15, SERIAL_RESP_SIZE - 15);
+    TEST_CHECK (rx_frame (&tport, rx_msg, 100) == 1);
+    TEST_CHECK (!memcmp (rx_msg, frame, SERIAL_RESP_SIZE));
+
+    /* 한번에 수신된 frame 2 개 */
+    memcpy (two, frame2, SERIAL_RESP_SIZE);
+    memcpy (two + SERIAL_RESP_SIZE, frame, SERIAL_RESP_SIZE);
+    send_part (cfd, two, sizeof(two));
+    TEST_CHECK (rx_frame (&tport, rx_msg, 100) == 1);
+    TEST_CHECK (!memcmp (rx_msg, frame2, SERIAL_RESP_SIZE));
+    TEST_CHECK (rx_frame (&tport, rx_msg, 100) == 1);
+    TEST_CHECK (!memcmp (rx_msg, frame, SERIAL_RESP_SIZE));
+
+    /* frame 중간에 끊어진 경우 재연결 후 이전 data 는 버림 */
+    send_part (cfd, frame, SERIAL_RESP_SIZE / 2);
+    TEST_CHECK (rx_frame (&tport, rx_msg, 10) == 0);
+    close (cfd);
+    TEST_CHECK (rx_frame (&tport, rx_msg, 10) == 0);
+    TEST_CHECK (tport.fd < 0);
+
+    tport.retry = 0;
+    TEST_CHECK (rx_frame (&tport, rx_msg, 10) == 0);
+    TEST_CHECK (tport.fd >= 0);
+    TEST_CHECK ((cfd = accept (sfd, NULL, NULL)) >= 0);
+    send_part (cfd, frame2 + SERIAL_RESP_SIZE / 2, SERIAL_RESP_SIZE - SERIAL_RESP_SIZE / 2);
+    send_part (cfd, frame2, SERIAL_RESP_SIZE);
+    TEST_CHECK (rx_frame (&tport, rx_msg, 100) == 1);
+    TEST_CHECK (!memcmp (rx_msg, frame2, SERIAL_RESP_SIZE));
+    TEST_CHECK (rx_frame (&tport, rx_msg, 10) == 0);
+
+    close (cfd);
+    transport_close (&tport);
+    close (sfd);
+    unlink (path);
+}
+
+//------------------------------------------------------------------------------
+int main (void)
+{
+    test_unix    ();
+    test_tcp     ();
+    test_framing ();
+
+    return test_result (__FILE__);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,279 @@
+//------------------------------------------------------------------------------
+/**
+ * @file test_order.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client adaptive test ordering & fail-fast.
+ * @version 0.1
+ * @date 2025-10-10
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+#include "client.h"
+#include "test_order.h"
+
+//------------------------------------------------------------------------------
+//
+// client.cfg
+//   ORDER,0,0,                     : ui cfg 'I' line 순서 (기존 방식)
+//   ORDER,1,1,/var/tmp/xxx.stat,   : adaptive 순서, 첫번째 hard fail 시 검사 중단
+//
+// adaptive : 항목별 누적 fail 율 / 평균 검사시간 이 큰 항목부터 검사.
+//            (불량 보드에서 첫번째 fail 까지의 예상 시간이 최소가 되는 순서)
+//            fail 율 = (fails + 1) / (runs + 2), 기록이 없는 항목은 ORDER_DEFAULT_MS.
+//            선행 조건이 있는 항목은 cfg 위치에 고정하고 나머지 항목만 재배치함.
+//              eGID_FW       : USB hub f/w upgrade (완료 후 RunningTime 초기화)
+//              eGID_ETHERNET : iperf 결과를 eth LED(100M/1G) 검사에서 사용
+//              eth LED       : iperf 이후 검사
+// abort    : 항목이 complete 되었으나 status 가 fail 인 경우 (재검사 하지 않는 항목)
+//            server 'X' command 와 같이 검사를 중단하고 결과를 출력함.
+//            local 에서 'F' 로 판정되었으나 server ack 가 없는 항목은 check loop 에서
+//            다시 검사하므로 (연결 대기중인 USB 등) hard fail 로 보지 않음.
+//
+// stat file : 검사 종료(print_test_result) 시 complete 된 항목만 저장
+//   gid, did, runs, fails, avg_ms,
+//
+//------------------------------------------------------------------------------
+typedef struct order_stat__t {
+    int     gid, did;
+    long    runs, fails, avg_ms;
+}   order_stat_t;
+
+static struct {
+    int     policy, abort;
+    char    fname[STR_PATH_LENGTH];
+
+    /* stat file */
+    order_stat_t    stat[ORDER_ITEM_MAX];
+    int     stat_cnt, loaded;
+
+    /* 현재 run */
+    int     order[ORDER_ITEM_MAX];
+    long    run_ms[ORDER_ITEM_MAX];
+    char    tested[ORDER_ITEM_MAX];
+    double  score[ORDER_ITEM_MAX];
+    int     item_cnt, aborted, saved;
+}   Order = { .policy = eORDER_CFG, .fname = ORDER_STAT_FILE };
+
+//------------------------------------------------------------------------------
+// ORDER, policy, abort, stat file,
+//------------------------------------------------------------------------------
+void test_order_config (char *line)
+{
+    char *item;
+
+    if (strtok (line, ",") == NULL)             return;
+    if ((item = strtok (NULL, ",")) == NULL)    return;
+    Order.policy = atoi (item);
+    if ((item = strtok (NULL, ",")) != NULL)
+        Order.abort = atoi (item);
+    if (((item = strtok (NULL, ",\n")) != NULL) && (item[0] == '/'))
+        strncpy (Order.fname, item, sizeof(Order.fname) -1);
+
+    if ((Order.policy < 0) || (Order.policy >= eORDER_END))
+        Order.policy = eORDER_CFG;
+}
+
+//------------------------------------------------------------------------------
+static order_stat_t *order_stat (int gid, int did, int add)
+{
+    int i;
+
+    for (i = 0; i < Order.stat_cnt; i++)
+        if ((Order.stat[i].gid == gid) && (Order.stat[i].did == did))
+            return &Order.stat[i];
+
+    if (!add || (Order.stat_cnt >= ORDER_ITEM_MAX))
+        return NULL;
+
+    memset (&Order.stat[Order.stat_cnt], 0, sizeof(order_stat_t));
+    Order.stat[Order.stat_cnt].gid = gid;
+    Order.stat[Order.stat_cnt].did = did;
+    return &Order.stat[Order.stat_cnt++];
+}
+
+//------------------------------------------------------------------------------
+static void order_load (void)
+{
+    FILE *fp;
+    char buf[128];
+    order_stat_t s, *ps;
+
+    if (Order.loaded)   return;
+    Order.loaded = 1;
+
+    if ((fp = fopen (Order.fname, "r")) == NULL)
+        return;
+
+    while (fgets (buf, sizeof(buf), fp) != NULL) {
+        if (buf[0] == '#')  continue;
+        if (sscanf (buf, "%d,%d,%ld,%ld,%ld", &s.gid, &s.did, &s.runs, &s.fails, &s.avg_ms) != 5)
+            continue;
+        if ((ps = order_stat (s.gid, s.did, 1)) != NULL)
+            *ps = s;
+    }
+    fclose (fp);
+}
+
+//------------------------------------------------------------------------------
+// return 1 : cfg 위치 고정 항목 (선행 조건 있음)
+//------------------------------------------------------------------------------
+static int order_pinned (i_item_t *i_item)
+{
+    int id = DEVICE_ID(i_item->dev_id);
+
+    switch (i_item->grp_id) {
+        case eGID_FW: case eGID_ETHERNET:
+            return 1;
+        case eGID_LED:
+            return (id == eLED_100M) || (id == eLED_1G);
+        default :
+            return 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+// 검사 시작시 (thread_check_func) 1회 호출
+//------------------------------------------------------------------------------
+void test_order_build (client_t *p)
+{
+    int sorted[ORDER_ITEM_MAX], i, j, cnt, pinned;
+
+    Order.item_cnt = (p->pui->i_item_cnt > ORDER_ITEM_MAX) ? ORDER_ITEM_MAX : p->pui->i_item_cnt;
+    Order.aborted  = Order.saved = 0;
+    memset (Order.run_ms, 0, sizeof(Order.run_ms));
+    memset (Order.tested, 0, sizeof(Order.tested));
+
+    for (i = 0; i < Order.item_cnt; i++)
+        Order.order[i] = i;
+
+    if (Order.policy == eORDER_CFG)     return;
+
+    order_load ();
+
+    for (i = 0; i < Order.item_cnt; i++) {
+        i_item_t *i_item = &p->pui->i_item[i];
+        order_stat_t *ps = order_stat (i_item->grp_id, i_item->dev_id, 0);
+        long   ms    = (ps && ps->avg_ms) ? ps->avg_ms : ORDER_DEFAULT_MS;
+        double rate  = ps ? (ps->fails + 1.0) / (ps->runs + 2.0) : 0.5;
+
+        Order.score[i] = rate / (ms ? ms : 1);
+    }
+
+    /* 고정 항목을 제외하고 score 내림차순 (같은 score 는 cfg 순서 유지) */
+    for (i = 0, cnt = 0; i < Order.item_cnt; i++) {
+        if (order_pinned (&p->pui->i_item[i]))  continue;
+
+        for (j = cnt; (j > 0) && (Order.score[sorted[j -1]] < Order.score[i]); j--)
+            sorted[j] = sorted[j -1];
+        sorted[j] = i;  cnt++;
+    }
+
+    /* 고정 항목은 cfg 위치, 빈 위치에 정렬된 항목 배치 */
+    for (i = 0, j = 0, pinned = 0; i < Order.item_cnt; i++) {
+        if (order_pinned (&p->pui->i_item[i]))
+            pinned++;
+        else
+            Order.order[i] = sorted[j++];
+    }
+
+    printf ("%s : adaptive order (%d items, %d pinned, %d stats, abort %s)\n", __func__,
+            Order.item_cnt, pinned, Order.stat_cnt, Order.abort ? "enable" : "disable");
+    for (i = 0; i < Order.item_cnt && i < 8; i++) {
+        i_item_t *i_item = &p->pui->i_item[Order.order[i]];
+        printf ("%s : %d : %s (gid = %d, did = %d)\n", __func__,
+                i, i_item->name, i_item->grp_id, i_item->dev_id);
+    }
+}
+
+//------------------------------------------------------------------------------
+int test_order_item (int pos)
+{
+    return ((pos < Order.item_cnt) && (pos >= 0)) ? Order.order[pos] : pos;
+}
+
+//------------------------------------------------------------------------------
+void test_order_time (int check_item, long ms)
+{
+    if ((check_item >= 0) && (check_item < Order.item_cnt)) {
+        Order.run_ms[check_item] += ms;
+        Order.tested[check_item]  = 1;
+    }
+}
+
+//------------------------------------------------------------------------------
+// return 1 : hard fail 발생 (검사 중단, 이후 계속 1)
+// server ack 로 complete 된 항목만 확인함. (unacked local fail 은 재검사 대상)
+//------------------------------------------------------------------------------
+int test_order_abort (client_t *p)
+{
+    int i;
+
+    if (!Order.abort)   return 0;
+    if (Order.aborted)  return 1;
+
+    for (i = 0; i < Order.item_cnt; i++) {
+        i_item_t *i_item = &p->pui->i_item[i];
+
+        if (i_item->complete && (i_item->status != 1)) {
+            printf ("%s : hard fail %s (gid = %d, did = %d), stop test.\n",
+                    __func__, i_item->name, i_item->grp_id, i_item->dev_id);
+            Order.aborted = 1;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// 검사한 항목의 fail 여부, 검사시간 누적 후 저장 (run 당 1회)
+//------------------------------------------------------------------------------
+void test_order_save (client_t *p)
+{
+    FILE *fp;
+    int i;
+
+    if ((Order.policy == eORDER_CFG) || Order.saved)    return;
+    Order.saved = 1;
+
+    order_load ();
+
+    for (i = 0; i < Order.item_cnt; i++) {
+        i_item_t *i_item = &p->pui->i_item[i];
+        order_stat_t *ps;
+
+        /* 검사하지 않은 항목, ack 대기중 중단된 항목 (abort, force stop) 은 제외 */
+        if (!Order.tested[i] || !i_item->complete)  continue;
+        if ((ps = order_stat (i_item->grp_id, i_item->dev_id, 1)) == NULL)
+            continue;
+
+        ps->avg_ms = (ps->avg_ms * ps->runs + Order.run_ms[i]) / (ps->runs + 1);
+        ps->runs++;
+        if (i_item->status != 1)
+            ps->fails++;
+    }
+
+    if ((fp = fopen (Order.fname, "w")) == NULL) {
+        printf ("%s : %s open error!\n", __func__, Order.fname);
+        return;
+    }
+    fprintf (fp, "# gid, did, runs, fails, avg_ms,\n");
+    for (i = 0; i < Order.stat_cnt; i++)
+        fprintf (fp, "%d,%d,%ld,%ld,%ld,\n", Order.stat[i].gid, Order.stat[i].did,
+                Order.stat[i].runs, Order.stat[i].fails, Order.stat[i].avg_ms);
+    fclose (fp);
+
+    printf ("%s : %d stats -> %s\n", __func__, Order.stat_cnt, Order.fname);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,45 @@
+//------------------------------------------------------------------------------
+/**
+ * @file test_order.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client adaptive test ordering & fail-fast.
+ * @version 0.1
+ * @date 2025-10-10
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef	__TEST_ORDER_H__
+#define	__TEST_ORDER_H__
+
+//------------------------------------------------------------------------------
+/* client.cfg : ORDER, policy, abort on hard fail, stat file, */
+enum { eORDER_CFG = 0, eORDER_ADAPTIVE, eORDER_END };
+
+#define ORDER_STAT_FILE     "/var/tmp/odroid-jig-order.stat"
+#define ORDER_ITEM_MAX      256
+
+/* 기록이 없는 항목의 예상 검사 시간 (ms) */
+#define ORDER_DEFAULT_MS    500
+
+//------------------------------------------------------------------------------
+// function prototype define
+//------------------------------------------------------------------------------
+struct client__t;
+
+extern  void    test_order_config   (char *line);
+extern  void    test_order_build    (struct client__t *p);
+extern  int     test_order_item     (int pos);
+extern  void    test_order_time     (int check_item, long ms);
+extern  int     test_order_abort    (struct client__t *p);
+extern  void    test_order_save     (struct client__t *p);
+
+//------------------------------------------------------------------------------
+#endif	// #define	__TEST_ORDER_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
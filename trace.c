@@ -0,0 +1,199 @@
+//------------------------------------------------------------------------------
+/**
+ * @file trace.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client span tracing (Chrome/Perfetto json).
+ * @version 0.1
+ * @date 2025-10-06
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include "trace.h"
+
+#if defined(__TRACE__)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <signal.h>
+#include <sys/syscall.h>
+
+//------------------------------------------------------------------------------
+//
+// span 은 호출 thread 의 ring buffer 에만 기록 (writer 1 개, lock 없음).
+// head 는 event 기록 후 release store 하고 dump 시 acquire load 로 읽음.
+// timestamp 는 CLOCK_MONOTONIC (vDSO, ARM64 는 rdtsc 가 없으므로 동일 경로 사용).
+// slot 은 thread 의 첫 trace 시 할당하고 재사용하지 않음. trace 하는 thread 는
+// main(RX), thread_ui, thread_check 뿐이고 soft reset('B') 에서도 다시 생성하지 않으므로
+// TRACE_THREAD_MAX 를 넘지 않음. (넘는 경우 해당 thread 는 기록하지 않음)
+//
+//------------------------------------------------------------------------------
+typedef struct trace_event__t {
+    const char  *name;
+    uint64_t    ts, dur;    /* ns */
+}   trace_event_t;
+
+typedef struct trace_buf__t {
+    const char      *name;
+    int             tid;
+    uint32_t        head;
+    trace_event_t   ev[TRACE_EVENT_MAX];
+}   trace_buf_t;
+
+static trace_buf_t *TraceBuf[TRACE_THREAD_MAX];
+static uint32_t     TraceCnt = 0;
+static uint64_t     TraceBase = 0;
+static volatile sig_atomic_t TraceRequest = 0;
+
+static __thread trace_buf_t *ThreadBuf = NULL;
+
+//------------------------------------------------------------------------------
+uint64_t trace_now (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+// 새 slot 할당. return NULL : TRACE_THREAD_MAX 초과
+//------------------------------------------------------------------------------
+static trace_buf_t *trace_slot (void)
+{
+    trace_buf_t *pb;
+    uint32_t i;
+
+    if ((i = __atomic_fetch_add (&TraceCnt, 1, __ATOMIC_RELAXED)) >= TRACE_THREAD_MAX) {
+        __atomic_fetch_sub (&TraceCnt, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+    if ((pb = calloc (1, sizeof(trace_buf_t))) == NULL)
+        return NULL;
+
+    __atomic_store_n (&TraceBuf[i], pb, __ATOMIC_RELEASE);
+    return pb;
+}
+
+//------------------------------------------------------------------------------
+static trace_buf_t *trace_buf (void)
+{
+    if (ThreadBuf != NULL)  return ThreadBuf;
+
+    /* thread 당 1회 등록 */
+    if ((ThreadBuf = trace_slot ()) == NULL)
+        return NULL;
+
+    ThreadBuf->tid  = (int)syscall (SYS_gettid);
+    ThreadBuf->name = "thread";
+    return ThreadBuf;
+}
+
+//------------------------------------------------------------------------------
+void trace_thread (const char *name)
+{
+    trace_buf_t *pb = trace_buf ();
+
+    if (pb != NULL)     pb->name = name;
+}
+
+//------------------------------------------------------------------------------
+void trace_span (const char *name, uint64_t ts)
+{
+    trace_buf_t *pb = trace_buf ();
+    trace_event_t *pe;
+    uint32_t head;
+
+    if (pb == NULL)     return;
+
+    head = pb->head;
+    pe = &pb->ev[head % TRACE_EVENT_MAX];
+    pe->name = name;
+    pe->ts   = ts;
+    pe->dur  = trace_now () - ts;
+    __atomic_store_n (&pb->head, head + 1, __ATOMIC_RELEASE);
+}
+
+//------------------------------------------------------------------------------
+// signal handler 에서는 요청만 기록하고 main loop(trace_poll) 에서 저장
+//------------------------------------------------------------------------------
+static void trace_signal (int sig)
+{
+    (void)sig;
+    TraceRequest = 1;
+}
+
+//------------------------------------------------------------------------------
+void trace_setup (void)
+{
+    TraceBase = trace_now ();
+    signal (SIGUSR1, trace_signal);
+    printf ("%s : kill -USR1 %d or 'E' command -> %s\n", __func__, getpid (), TRACE_FILE);
+}
+
+//------------------------------------------------------------------------------
+void trace_poll (void)
+{
+    if (TraceRequest) {
+        TraceRequest = 0;
+        trace_dump (TRACE_FILE);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Chrome trace event format (complete event 'X', thread_name metadata 'M')
+//------------------------------------------------------------------------------
+int trace_dump (const char *fname)
+{
+    FILE *fp;
+    uint32_t i, cnt, head, pos;
+    long events = 0;
+    int pid = getpid ();
+
+    if ((fp = fopen (fname, "w")) == NULL) {
+        printf ("%s : %s open error!\n", __func__, fname);
+        return 0;
+    }
+    fprintf (fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+    cnt = __atomic_load_n (&TraceCnt, __ATOMIC_RELAXED);
+    for (i = 0; i < cnt && i < TRACE_THREAD_MAX; i++) {
+        trace_buf_t *pb = __atomic_load_n (&TraceBuf[i], __ATOMIC_ACQUIRE);
+
+        if (pb == NULL)     continue;
+
+        fprintf (fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                     "\"args\":{\"name\":\"%s\"}}\n", events++ ? "," : "", pid, pb->tid, pb->name);
+
+        head = __atomic_load_n (&pb->head, __ATOMIC_ACQUIRE);
+        /* ring buffer 가 넘친 경우 최근 TRACE_EVENT_MAX 개 (기록중인 1개 제외) */
+        pos  = (head > TRACE_EVENT_MAX) ? (head - TRACE_EVENT_MAX + 1) : 0;
+        for (; pos < head; pos++) {
+            trace_event_t *pe = &pb->ev[pos % TRACE_EVENT_MAX];
+
+            if (pe->ts < TraceBase)     continue;
+            fprintf (fp, ",{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+                         "\"ts\":%.3f,\"dur\":%.3f}\n",
+                         pe->name, pid, pb->tid,
+                         (pe->ts - TraceBase) / 1000.0, pe->dur / 1000.0);
+            events++;
+        }
+    }
+    fprintf (fp, "]}\n");
+    fclose (fp);
+
+    printf ("%s : %ld events, %d threads -> %s\n", __func__, events, cnt, fname);
+    return 1;
+}
+
+#endif  // #if defined(__TRACE__)
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,65 @@
+//------------------------------------------------------------------------------
+/**
+ * @file trace.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client span tracing (Chrome/Perfetto json).
+ * @version 0.1
+ * @date 2025-10-06
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef	__TRACE_H__
+#define	__TRACE_H__
+
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Makefile : CFLAGS += -D__TRACE__ 인 경우에만 동작. (미사용시 code 생성 안됨)
+//
+// 'E' command 수신 또는 kill -USR1 {pid} 시 TRACE_FILE 로 저장.
+// chrome://tracing 또는 https://ui.perfetto.dev 에서 open.
+//------------------------------------------------------------------------------
+#define TRACE_FILE          "/tmp/odroid-jig-trace.json"
+
+/* thread 당 event ring buffer 크기, 최대 thread 수 */
+#define TRACE_EVENT_MAX     16384
+#define TRACE_THREAD_MAX    16
+
+//------------------------------------------------------------------------------
+#if defined(__TRACE__)
+
+extern  uint64_t    trace_now       (void);
+extern  void        trace_span      (const char *name, uint64_t ts);
+extern  void        trace_thread    (const char *name);
+extern  void        trace_setup     (void);
+extern  void        trace_poll      (void);
+extern  int         trace_dump      (const char *fname);
+
+#define TRACE_BEGIN(t)          uint64_t t = trace_now ()
+#define TRACE_END(t, name)      trace_span (name, t)
+#define TRACE_THREAD(name)      trace_thread (name)
+#define TRACE_SETUP()           trace_setup ()
+#define TRACE_POLL()            trace_poll ()
+#define TRACE_DUMP()            trace_dump (TRACE_FILE)
+
+#else
+
+#define TRACE_BEGIN(t)
+#define TRACE_END(t, name)
+#define TRACE_THREAD(name)
+#define TRACE_SETUP()
+#define TRACE_POLL()
+#define TRACE_DUMP()
+
+#endif  // #if defined(__TRACE__)
+
+//------------------------------------------------------------------------------
+#endif	// #define	__TRACE_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
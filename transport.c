@@ -0,0 +1,368 @@
+//------------------------------------------------------------------------------
+/**
+ * @file transport.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client protocol transport (UART, TCP, Unix socket).
+ * @version 0.1
+ * @date 2025-09-26
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+//------------------------------------------------------------------------------
+#include "transport.h"
+#include "session.h"
+#include "trace.h"
+
+//------------------------------------------------------------------------------
+//
+// client.cfg
+//   TRANSPORT,uart,
+//   TRANSPORT,tcp,192.168.0.10:8800,
+//   TRANSPORT,unix,/tmp/odroid-jig.sock,
+//
+// socket 이 연결된 경우 socket 으로 송신하고, 연결이 안되거나 끊어진 경우
+// UART 로 송신함. (TRANSPORT_RETRY_SEC 간격으로 재연결)
+// 수신은 socket, UART 모두 처리하며 frame 형식은 같음.
+// session replay (-r) 중에는 trace 파일의 RX frame 만 사용함.
+//
+// 재연결은 RX loop 를 막지 않도록 non-blocking connect 후 다음 호출에서
+// 완료 여부만 확인함. (poll timeout 0, TRANSPORT_CONNECT_MS 경과시 실패)
+// read/write 는 fd 를 참조(ref) 한 상태로 사용하고, disconnect 된 fd 는
+// 마지막 참조가 끝난 후 close 됨. (사용중인 fd 번호가 재사용 되지 않음)
+// 연결은 RX, check thread 어느 쪽에서도 될 수 있으므로 수신 buffer 와 frame 상태는
+// 연결 gen 이 바뀐 것을 확인한 RX thread(transport_read) 에서만 초기화함.
+//
+//------------------------------------------------------------------------------
+static const char *TransportName[eTRANSPORT_END] = { "uart", "tcp", "unix" };
+
+//------------------------------------------------------------------------------
+int transport_type (const char *name)
+{
+    int i;
+
+    for (i = 0; i < eTRANSPORT_END; i++) {
+        if (!strncmp (name, TransportName[i], strlen(TransportName[i])))
+            return i;
+    }
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+static int transport_sockaddr (transport_t *pt, struct sockaddr_storage *sa, socklen_t *len)
+{
+    memset (sa, 0, sizeof(struct sockaddr_storage));
+
+    if (pt->type == eTRANSPORT_UNIX) {
+        struct sockaddr_un *su = (struct sockaddr_un *)sa;
+
+        su->sun_family = AF_UNIX;
+        if (snprintf (su->sun_path, sizeof(su->sun_path), "%s", pt->addr) >= (int)sizeof(su->sun_path))
+            return -1;
+        *len = sizeof(struct sockaddr_un);
+        return AF_UNIX;
+    } else {
+        struct sockaddr_in *si = (struct sockaddr_in *)sa;
+        char ip[STR_NAME_LENGTH], *port;
+
+        if (snprintf (ip, sizeof(ip), "%s", pt->addr) >= (int)sizeof(ip))
+            return -1;
+        if ((port = strchr (ip, ':')) == NULL)
+            return -1;
+        *port++ = 0;
+
+        si->sin_family = AF_INET;
+        si->sin_port   = htons (atoi (port));
+        if (inet_pton (AF_INET, ip, &si->sin_addr) != 1)
+            return -1;
+        *len = sizeof(struct sockaddr_in);
+        return AF_INET;
+    }
+}
+
+//------------------------------------------------------------------------------
+static long elapsed_ms (struct timespec *ts)
+{
+    struct timespec now;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - ts->tv_sec) * 1000 + (now.tv_nsec - ts->tv_nsec) / 1000000;
+}
+
+//------------------------------------------------------------------------------
+// pt->mutex lock 상태에서 호출
+//------------------------------------------------------------------------------
+static void transport_connected (transport_t *pt, int fd)
+{
+    if (pt->type == eTRANSPORT_TCP) {
+        int on = 1;
+        setsockopt (fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+    pt->fd   = fd;
+    pt->cfd  = -1;
+    pt->gen++;
+    printf ("%s : %s %s connected.\n", __func__, TransportName[pt->type], pt->addr);
+}
+
+//------------------------------------------------------------------------------
+// return 1 : socket 연결됨, 0 : UART 사용 (연결중 포함, block 되지 않음)
+//------------------------------------------------------------------------------
+static int transport_connect (transport_t *pt)
+{
+    struct sockaddr_storage sa;
+    struct pollfd pfd;
+    socklen_t len;
+    int fd, family, err = 0;
+
+    if (pt->type == eTRANSPORT_UART)    return 0;
+    if (pt->fd >= 0)                    return 1;
+    if ((pt->cfd < 0) && (time (NULL) < pt->retry))
+        return 0;
+
+    pthread_mutex_lock (&pt->mutex);
+    if (pt->fd >= 0)
+        goto out;
+
+    /* 연결중 : 완료 여부만 확인 */
+    if (pt->cfd >= 0) {
+        pfd.fd = pt->cfd;   pfd.events = POLLOUT;   pfd.revents = 0;
+        if (poll (&pfd, 1, 0) == 1) {
+            len = sizeof(err);
+            if ((getsockopt (pt->cfd, SOL_SOCKET, SO_ERROR, &err, &len) == 0) && !err)
+                transport_connected (pt, pt->cfd);
+            else
+                goto err_out;
+        }
+        else if (elapsed_ms (&pt->cstart) >= TRANSPORT_CONNECT_MS)
+            goto err_out;
+        goto out;
+    }
+
+    /* 이전 연결의 fd 가 아직 사용중인 경우 close 후 재연결 */
+    if ((pt->dfd >= 0) || (time (NULL) < pt->retry))
+        goto out;
+    pt->retry = time (NULL) + TRANSPORT_RETRY_SEC;
+
+    if ((family = transport_sockaddr (pt, &sa, &len)) < 0) {
+        printf ("%s : address error! (%s)\n", __func__, pt->addr);
+        pt->type = eTRANSPORT_UART;
+        goto out;
+    }
+
+    if ((fd = socket (family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) < 0)
+        goto out;
+
+    if (connect (fd, (struct sockaddr *)&sa, len) == 0)
+        transport_connected (pt, fd);
+    else if (errno == EINPROGRESS) {
+        pt->cfd = fd;
+        clock_gettime (CLOCK_MONOTONIC, &pt->cstart);
+    }
+    else
+        close (fd);
+    goto out;
+
+err_out:
+    close (pt->cfd);
+    pt->cfd = -1;
+out:
+    pthread_mutex_unlock (&pt->mutex);
+    return (pt->fd >= 0);
+}
+
+//------------------------------------------------------------------------------
+// 연결된 fd 참조. return : fd, -1 : 연결 안됨 (gen : fd 의 연결 gen)
+//------------------------------------------------------------------------------
+static int transport_get (transport_t *pt, int *gen)
+{
+    int fd;
+
+    pthread_mutex_lock (&pt->mutex);
+    if ((fd = pt->fd) >= 0)
+        pt->ref++;
+    if (gen != NULL)
+        *gen = pt->gen;
+    pthread_mutex_unlock (&pt->mutex);
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+// 참조 해제. err 인 경우 disconnect (fd 는 마지막 참조 해제시 close)
+//------------------------------------------------------------------------------
+static void transport_put (transport_t *pt, int fd, int err)
+{
+    pthread_mutex_lock (&pt->mutex);
+    pt->ref--;
+    if (err && (pt->fd == fd)) {
+        printf ("%s : %s %s disconnected. (uart fallback)\n",
+                __func__, TransportName[pt->type], pt->addr);
+        pt->dfd   = fd;
+        pt->fd    = -1;
+        pt->retry = time (NULL) + TRANSPORT_RETRY_SEC;
+    }
+    if ((pt->dfd >= 0) && !pt->ref) {
+        close (pt->dfd);
+        pt->dfd = -1;
+    }
+    pthread_mutex_unlock (&pt->mutex);
+}
+
+//------------------------------------------------------------------------------
+int transport_init (transport_t *pt, uart_t *puart)
+{
+    struct timespec ts;
+
+    pt->fd    = pt->cfd = pt->dfd = -1;
+    pt->ref   = pt->gen = pt->rx_gen = 0;
+    pt->retry = 0;
+    pt->puart = puart;
+    pthread_mutex_init (&pt->mutex, NULL);
+
+    if ((pt->type < 0) || (pt->type >= eTRANSPORT_END))
+        pt->type = eTRANSPORT_UART;
+
+    /* 처음 연결은 boot msg 가 socket 으로 전송되도록 TRANSPORT_CONNECT_MS 까지 대기 */
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    while (!transport_connect (pt) && (pt->cfd >= 0) && (elapsed_ms (&ts) < TRANSPORT_CONNECT_MS))
+        usleep (1000);
+
+    printf ("%s : %s %s, uart %s\n", __func__, TransportName[pt->type],
+            (pt->type != eTRANSPORT_UART) ? pt->addr : "",
+            puart ? "enable" : "disable");
+
+    return (pt->fd >= 0) || (pt->puart != NULL);
+}
+
+//------------------------------------------------------------------------------
+void transport_close (transport_t *pt)
+{
+    pthread_mutex_lock (&pt->mutex);
+    if (pt->fd  >= 0)   close (pt->fd);
+    if (pt->cfd >= 0)   close (pt->cfd);
+    if (pt->dfd >= 0)   close (pt->dfd);
+    pt->fd = pt->cfd = pt->dfd = -1;
+    pthread_mutex_unlock (&pt->mutex);
+}
+
+//------------------------------------------------------------------------------
+// socket 에서 1 byte read. return 1 : data, 0 : no data
+//------------------------------------------------------------------------------
+int transport_read (transport_t *pt, unsigned char *data)
+{
+    // option -r : session replay
+    if (session_replay_active ())
+        return session_replay_read (data);
+
+    if (!transport_connect (pt))    return 0;
+
+    if (pt->ipos >= pt->ilen) {
+        int fd, len, gen;
+
+        if ((fd = transport_get (pt, &gen)) < 0)
+            return 0;
+
+        /* 새 연결 : 이전 연결에서 받다 만 frame 은 버림 */
+        if (pt->rx_gen != gen) {
+            pt->rx_gen = gen;
+            pt->cnt    = pt->p_sp = 0;
+        }
+        len = recv (fd, pt->ibuf, sizeof(pt->ibuf), 0);
+        transport_put (pt, fd,
+            (len == 0) || ((len < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)));
+
+        if (len <= 0)
+            return 0;
+        pt->ipos = 0;   pt->ilen = len;
+    }
+    *data = pt->ibuf[pt->ipos++];
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// socket 송신. EAGAIN(송신 buffer full) 은 TRANSPORT_SEND_MS 까지 재시도.
+// 일부만 송신된 경우 server 의 frame 이 깨지므로 연결을 끊음. (재연결, UART fallback)
+// return : 송신 size, -1 : 송신 실패 (연결 끊어짐)
+//------------------------------------------------------------------------------
+static int transport_send (transport_t *pt, const char *data, int size)
+{
+    struct pollfd pfd;
+    struct timespec ts;
+    int fd, len, sent = 0, err = 0;
+
+    if ((fd = transport_get (pt, NULL)) < 0)
+        return -1;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    while (sent < size) {
+        if ((len = send (fd, data + sent, size - sent, MSG_NOSIGNAL)) > 0) {
+            sent += len;
+            continue;
+        }
+        if ((len < 0) && (errno == EINTR))
+            continue;
+        if ((len < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+            if (elapsed_ms (&ts) >= TRANSPORT_SEND_MS)
+                break;
+            pfd.fd = fd;    pfd.events = POLLOUT;   pfd.revents = 0;
+            poll (&pfd, 1, TRANSPORT_SEND_MS);
+            continue;
+        }
+        err = 1;
+        break;
+    }
+    if (sent < size) {
+        printf ("%s : %s send %d/%d%s\n", __func__, TransportName[pt->type],
+                sent, size, err ? " (disconnect)" : " (timeout)");
+        err = 1;
+    }
+    transport_put (pt, fd, err);
+
+    return err ? -1 : sent;
+}
+
+//------------------------------------------------------------------------------
+int transport_write (transport_t *pt, const void *data, int size)
+{
+    // option -r : session replay (server 없음)
+    if (session_replay_active ())
+        return size;
+
+    if (transport_connect (pt)) {
+        int sent;
+
+        TRACE_BEGIN (t_send);
+        sent = transport_send (pt, data, size);
+        TRACE_END (t_send, "socket_write");
+        if (sent >= 0)
+            return sent;
+    }
+    if (pt->puart == NULL)  return 0;
+
+    {
+        TRACE_BEGIN (t_uart);
+        size = uart_write (pt->puart, (void *)data, size);
+        TRACE_END (t_uart, "uart_write");
+    }
+    return size;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,74 @@
+//------------------------------------------------------------------------------
+/**
+ * @file transport.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-JIG Client protocol transport (UART, TCP, Unix socket).
+ * @version 0.1
+ * @date 2025-09-26
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef	__TRANSPORT_H__
+#define	__TRANSPORT_H__
+
+#include <time.h>
+#include <pthread.h>
+#include "lib_uart/lib_uart.h"
+#include "lib_dev_check/lib_dev_check.h"
+
+//------------------------------------------------------------------------------
+enum { eTRANSPORT_UART, eTRANSPORT_TCP, eTRANSPORT_UNIX, eTRANSPORT_END };
+
+/* socket 연결 실패시 재연결 간격 (sec), connect timeout (ms), send 재시도 (ms) */
+#define TRANSPORT_RETRY_SEC     5
+#define TRANSPORT_CONNECT_MS    500
+#define TRANSPORT_SEND_MS       100
+
+//------------------------------------------------------------------------------
+typedef struct transport__t {
+    int     type;
+    char    addr[STR_PATH_LENGTH];  /* tcp = ip:port, unix = socket path */
+
+    /* socket (-1 = 연결 안됨, UART 사용) */
+    int     fd;
+    time_t  retry;
+    pthread_mutex_t mutex;  /* connect/disconnect, fd ref (RX, check thread) */
+
+    /* cfd : non-blocking connect 진행중, dfd : disconnect 후 ref 해제 대기 */
+    int     cfd, dfd, ref;
+    struct timespec cstart;
+
+    /* 연결 gen (connect 마다 증가), rx_gen : RX thread 가 수신 상태를 초기화한 gen */
+    int     gen, rx_gen;
+
+    /* socket recv buffer */
+    unsigned char   ibuf[256];
+    int     ipos, ilen;
+
+    /* socket frame (UART 와 같은 frame : '@' ~ '#', SERIAL_RESP_SIZE) */
+    unsigned char   rbuf[SERIAL_RESP_SIZE];
+    unsigned int    p_sp, cnt;
+
+    /* fallback */
+    uart_t  *puart;
+}   transport_t;
+
+//------------------------------------------------------------------------------
+// function prototype define
+//------------------------------------------------------------------------------
+extern  int     transport_type  (const char *name);
+extern  int     transport_init  (transport_t *pt, uart_t *puart);
+extern  void    transport_close (transport_t *pt);
+extern  int     transport_read  (transport_t *pt, unsigned char *data);
+extern  int     transport_write (transport_t *pt, const void *data, int size);
+
+//------------------------------------------------------------------------------
+#endif	// #define	__TRANSPORT_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------